@@ -0,0 +1,108 @@
+#ifndef ARENA_CPP
+#define ARENA_CPP
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+using namespace std;
+
+// Bump allocator over large slabs. Allocation is a pointer increment; nothing is freed on its
+// own - reset() rewinds to the first slab and keeps every slab for reuse, so a scratch arena
+// that is reset between uses stops allocating once it has grown to its working size.
+// Objects placed in the arena must be trivially destructible. Not thread-safe.
+class Arena {
+private:
+    static constexpr size_t DEFAULT_SLAB_BYTES = 64 * 1024;
+
+    vector<unique_ptr<char[]>> slabs;
+    vector<size_t> slabSizes;
+    size_t slabBytes;
+    size_t current;     // slab being filled
+    char* next;
+    char* limit;
+
+    void useSlab(size_t slab) {
+        current = slab;
+        next = slabs[slab].get();
+        limit = next + slabSizes[slab];
+    }
+
+    // Move to the next slab with room for bytes (+ alignment), allocating one if needed
+    void grow(size_t bytes, size_t align) {
+        size_t needed = bytes + align;
+        for (size_t slab = slabs.empty() ? 0 : current + 1; slab < slabs.size(); slab++) {
+            if (slabSizes[slab] >= needed) {
+                useSlab(slab);
+                return;
+            }
+        }
+        size_t size = needed > slabBytes ? needed : slabBytes;
+        slabs.emplace_back(new char[size]);
+        slabSizes.push_back(size);
+        useSlab(slabs.size() - 1);
+    }
+
+public:
+    explicit Arena(size_t slabSize = DEFAULT_SLAB_BYTES)
+        : slabBytes(slabSize), current(0), next(nullptr), limit(nullptr) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align = alignof(max_align_t)) {
+        size_t padding = (align - (size_t)next % align) % align;
+        if (next == nullptr || (size_t)(limit - next) < bytes + padding) {
+            grow(bytes, align);
+            padding = (align - (size_t)next % align) % align;
+        }
+        char* result = next + padding;
+        next = result + bytes;
+        return result;
+    }
+
+    // Copy of text inside the arena
+    string_view copy(string_view text) {
+        if (text.empty()) return string_view();
+        char* out = (char*)allocate(text.size(), 1);
+        memcpy(out, text.data(), text.size());
+        return string_view(out, text.size());
+    }
+
+    // The parts joined into one string inside the arena
+    string_view concat(initializer_list<string_view> parts) {
+        size_t length = 0;
+        for (string_view part : parts) length += part.size();
+        if (length == 0) return string_view();
+        char* out = (char*)allocate(length, 1);
+        char* p = out;
+        for (string_view part : parts) {
+            memcpy(p, part.data(), part.size());
+            p += part.size();
+        }
+        return string_view(out, length);
+    }
+
+    // Forget every allocation, keeping the slabs
+    void reset() {
+        if (!slabs.empty()) useSlab(0);
+    }
+
+    // Forget every allocation and free the slabs
+    void release() {
+        slabs.clear();
+        slabSizes.clear();
+        current = 0;
+        next = limit = nullptr;
+    }
+
+    size_t capacity() const {
+        size_t total = 0;
+        for (size_t size : slabSizes) total += size;
+        return total;
+    }
+};
+
+#endif
@@ -7,11 +7,25 @@
 #include <algorithm>
 #include <cctype>
 #include <sstream>
-#include <map>
-#include <set>
 #include <iterator>
 #include <chrono>
 #include <iomanip>
+#include <filesystem>
+#include "skills.cpp"
+#include "scoring.cpp"
+#include "thread_pool.cpp"
+#include "posting_index.cpp"
+#include "set_ops.cpp"
+#include "roaring.cpp"
+#include "csv_reader.cpp"
+#include "record_store.cpp"
+#include "arena.cpp"
+#include "snapshot.cpp"
+#include "live_index.cpp"
+#include "top_k.cpp"
+#include "max_score.cpp"
+#include "assignment.cpp"
+#include "result_sink.cpp"
 using namespace std;
 
 // Simple String Array class for storing strings 
@@ -21,12 +35,12 @@ private:
     int capacity;
     int currentSize;
     
-    void resize() {
-        int newCapacity = capacity * 2;
+    // Move the strings into a larger block (no string is copied)
+    void reallocate(int newCapacity) {
         string* newData = new string[newCapacity];
         
         for (int i = 0; i < currentSize; i++) {
-            newData[i] = data[i];
+            newData[i] = move(data[i]);
         }
         
         delete[] data;
@@ -35,19 +49,55 @@ private:
     }
     
 public:
-    StringArray(int initialCapacity = 10) : capacity(initialCapacity), currentSize(0) {
+    StringArray(int initialCapacity = 10) : capacity(max(initialCapacity, 1)), currentSize(0) {
         data = new string[capacity];
     }
     
+    StringArray(const StringArray& other) : capacity(max(other.currentSize, 1)), currentSize(other.currentSize) {
+        data = new string[capacity];
+        for (int i = 0; i < currentSize; i++) {
+            data[i] = other.data[i];
+        }
+    }
+    
+    StringArray(StringArray&& other) noexcept : data(other.data), capacity(other.capacity), currentSize(other.currentSize) {
+        other.data = nullptr;
+        other.capacity = 0;
+        other.currentSize = 0;
+    }
+    
+    StringArray& operator=(StringArray other) noexcept {
+        swap(data, other.data);
+        swap(capacity, other.capacity);
+        swap(currentSize, other.currentSize);
+        return *this;
+    }
+    
     ~StringArray() {
         delete[] data;
     }
     
+    void reserve(int newCapacity) {
+        if (newCapacity > capacity) reallocate(newCapacity);
+    }
+    
     void push_back(const string& item) {
+        emplace_back(item);
+    }
+    
+    void push_back(string&& item) {
+        emplace_back(move(item));
+    }
+    
+    // Construct the new last string from args (assigned into a slot of the block)
+    template<typename... Args>
+    string& emplace_back(Args&&... args) {
         if (currentSize >= capacity) {
-            resize();
+            reallocate(max(capacity * 2, 1));
         }
-        data[currentSize++] = item;
+        string& slot = data[currentSize++];
+        slot.assign(forward<Args>(args)...);
+        return slot;
     }
     
     string& operator[](int index) {
@@ -94,195 +144,246 @@ struct Resume;
 // Function declarations
 int calculateCompatibility(const Job& job, const Resume& resume);
 
-// Base class for data items
-class DataItem {
-public:
-    virtual ~DataItem() = default;
-    virtual string getText() const = 0;
-    virtual string getSkills() const = 0;
-    virtual void display() const = 0;
-};
-
-// Job structure
-struct Job : public DataItem {
+// Job record as parsed or inserted. Array<Job> keeps its records in columns (RecordStore);
+// a Job object only exists while a record is built or read back with getItem().
+struct Job {
     int id;
     string title;
-    string description;
     string skills;
-    string company;
-    string location;
-    string experience_level;
+    string description;     // empty = the standard "Job: <title> requiring <skills>"
+    SkillSet skillBits;     // skill IDs from the global skill dictionary
     
-    Job() = default;
+    Job() : id(-1) {}
     Job(const string& csvLine);
     
-    string getText() const override { return description; }
-    string getSkills() const override { return skills; }
-    void display() const override;
+    string getText() const { return description.empty() ? describe(title, skills) : description; }
     void parseFromCSV(const string& csvLine);
+    void parseFromFields(const CsvRecord& record);
     void parseFromDescription(const string& desc);
-    string filterTechnicalSkills(const string& rawSkills);
+    
+    // Standard text: TEXT_PREFIX + title + TEXT_INFIX + skills
+    static constexpr string_view TEXT_PREFIX = "Job: ";
+    static constexpr string_view TEXT_INFIX = " requiring ";
+    static string describe(string_view title, string_view skills) {
+        string text;
+        text.reserve(TEXT_PREFIX.size() + title.size() + TEXT_INFIX.size() + skills.size());
+        text.append(TEXT_PREFIX).append(title).append(TEXT_INFIX).append(skills);
+        return text;
+    }
 };
 
-// Resume structure
-struct Resume : public DataItem {
+// Resume record as parsed or inserted (kept in columns by Array<Resume>, like Job)
+struct Resume {
     int id;
-    string name;
-    string summary;
     string skills;
-    string experience;
-    string education;
-    string contact;
+    string summary;         // empty = the standard "Professional with skills in <skills>"
+    SkillSet skillBits;     // skill IDs from the global skill dictionary
     
-    Resume() = default;
+    Resume() : id(-1) {}
     Resume(const string& csvLine);
     
-    string getText() const override { return summary; }
-    string getSkills() const override { return skills; }
-    void display() const override;
+    string getText() const { return summary.empty() ? describe(skills) : summary; }
     void parseFromCSV(const string& csvLine);
+    void parseFromFields(const CsvRecord& record);
     void parseFromDescription(const string& desc);
-    string filterTechnicalSkills(const string& rawSkills);
-};
-
-// Match struct for storing search results
-struct Match {
-    int index;
-    int score;
+    
+    // Standard text: TEXT_PREFIX + skills
+    static constexpr string_view TEXT_PREFIX = "Professional with skills in ";
+    static string describe(string_view skills) { return string(TEXT_PREFIX) + string(skills); }
 };
 
-// Generic Array template for storing data items
+// Generic collection of jobs or resumes. Records are stored column by column (RecordStore)
+// and read through the row accessors; document IDs are row indexes.
 template<typename T>
 class Array {
 private:
-    T* dataArray;       // dynamic array for storing data items
-    int capacity;       // maximum allocated slots
-    int size;           // current number of items
-    void resize();      // private helper to increase capacity
-    
-    // Inverted Index for fast searching
-    map<string, set<int>> skillIndex;      // skill -> set of document IDs
-    map<string, set<int>> titleIndex;      // title words -> set of document IDs
-    map<string, set<int>> descriptionIndex; // description words -> set of document IDs
+    RecordStore records;
+    
+    // Document IDs are array slots: removed items stay as tombstones so IDs never shift
+    vector<uint8_t> tombstones; // 1 = removed (only as long as the highest removed ID)
+    int deletedCount;
+    
+    // Segmented inverted index for fast searching (skill, title and description terms -> document IDs),
+    // kept up to date by insert/update/remove; sealed segments are merged in the background
+    LiveIndex index;
     bool indexBuilt;    // flag to track if index is built
+    Arena termScratch;  // term text of insert / update / remove, reset after each change
     string normalizeText(const string& text) const;
+    void collectTerms(int row, DocumentTerms& terms, Arena& scratch) const; // index terms of one record
+    static void storeRow(RecordStore& store, int row, const T& item);      // write a record into columns
 
 public:
     // Constructor & Destructor
     Array(int initialCapacity = 10);
     ~Array();
 
-    // Core Functions
-    bool insert(const T& item);        // insert data item
-    bool remove(int index);            // remove at index
+    // Core Functions (the index is updated incrementally once built)
+    bool insert(const T& item);                // insert data item (ID = previous getSize())
+    bool update(int index, const T& item);     // replace a live item, keeping its ID
+    bool remove(int index);                    // remove at index (leaves a tombstone; IDs stay stable)
+    void clear();                              // drop all items and indexes
 
     // Getters
-    int getSize() const { return size; }
-    int getCapacity() const { return capacity; }
-    T getItem(int index) const;
+    int getSize() const { return records.size(); } // number of IDs handed out, including removed ones
+    void reserve(int rows, size_t textBytes = 0) { records.reserve(rows, textBytes); } // total rows, extra text
+    int getLiveCount() const { return getSize() - deletedCount; }
+    bool isLive(int index) const {
+        return index >= 0 && index < getSize() && (index >= (int)tombstones.size() || !tombstones[index]);
+    }
+    T getItem(int index) const;                // a copy of the record (default record if removed)
+    
+    // Row accessors (no copies; views stay valid until the collection changes)
+    int getId(int index) const { return records.id(index); }
+    string_view getTitle(int index) const { return records.title(index); } // "" for resumes
+    string_view getSkills(int index) const { return records.skillText(index); }
+    string getText(int index) const;           // description / summary
+    SkillSet getSkillSet(int index) const { return records.skillSet(index); }
+    void display(int index, string& out) const; // append the record's display lines
+    size_t getMemoryBytes() const { return records.memoryBytes(); }
     
     // File operations
-    bool loadFromCSV(const string& filename);
+    bool loadFromCSV(const string& filename, int numThreads = 0); // numThreads <= 0 = all cores
+    void writeSnapshot(SnapshotWriter& out);        // records + prebuilt indexes (compacts the index first)
+    bool readSnapshot(SnapshotReader& in);          // replaces the contents; empty on failure
     
     // Rule-based matching functions
-    void displayMatches(const string& keyword, int maxResults = 5) const;
-    
-    // Sorting and optimization functions
-    void quickSort(Match* matches, int low, int high) const;
-    int partition(Match* matches, int low, int high) const;
-    void getTopKMatches(Match* matches, int matchCount, int k, Match* topK) const;
+    // candidateCount / pruning (optional) receive the candidate count and the work the ranking took
+    vector<Match> searchBySkills(const string& keyword, int maxResults, int* candidateCount = nullptr,
+                                 PruningStats* pruning = nullptr) const;
+    void displayMatches(const string& keyword, int maxResults, ResultSink& sink) const;
     
     // Inverted Index functions
     void buildIndex();
-    void addToIndex(const string& text, int docId, map<string, set<int>>& index);
-    set<int> searchIndex(const string& keyword, const map<string, set<int>>& index) const;
-    set<int> booleanSearch(const string& query) const;
+    void addTokens(string_view text, vector<string_view>& terms, Arena& scratch) const;
+    DocIdList searchIndex(const string& keyword, IndexField field) const;
+    RoaringBitmap searchSkill(const string& skill) const;
+    DocIdList booleanSearch(const string& query) const;
     StringArray tokenize(const string& text) const;
     
     // Optimized job-resume matching functions
-    void findBestMatchesForJobs(const Array<Resume>& resumeStorage, int maxJobsToShow) const;
-    set<int> findCandidateResumes(const string& jobSkills) const;
-    
-    // Job title search function
-    void displayMatchesByTitle(const string& titleKeyword, int maxResults) const;
+    const SkillMatrix& getSkillMatrix() const { return records.skillMatrix(); } // skill column (removed rows are empty)
+    RoaringBitmap findSkillCandidates(const SkillSet& skills) const; // records sharing any of the skills
+    void findBestMatchesForJobs(const Array<Resume>& resumeStorage, int maxJobsToShow, ResultSink& sink, int numThreads = 0) const;
+    void findBestMatchesForResumes(const Array<Job>& jobStorage, int maxResumesToShow, ResultSink& sink, int numThreads = 0) const;
+    void assignResumes(const Array<Resume>& resumeStorage, int maxJobsToShow, ResultSink& sink,
+                       int resumeCapacity = 1, int numThreads = 0) const;
+    
+    // Job title search functions
+    vector<Match> searchByTitle(const string& titleKeyword, int maxResults, int* candidateCount = nullptr) const;
+    void displayMatchesByTitle(const string& titleKeyword, int maxResults, ResultSink& sink) const;
 };
 
-#endif
+// Record <-> column conversion and the record-specific views
+template<>
+void Array<Job>::storeRow(RecordStore& store, int row, const Job& job) {
+    store.setRow(row, job.id, job.title, job.skills, job.description, job.skillBits);
+}
 
-// Template specializations for buildIndex
 template<>
-void Array<Job>::buildIndex() {
-    if (indexBuilt) return; // Index already built
-    
-    // Clear existing indexes
-    skillIndex.clear();
-    titleIndex.clear();
-    descriptionIndex.clear();
-    
-    // Build indexes for each document
-    for (int i = 0; i < size; i++) {
-        // Index skills - split by comma first to handle multi-word skills as phrases
-        string skills = dataArray[i].getSkills();
-        istringstream skillStream(skills);
-        string skill;
-        while (getline(skillStream, skill, ',')) {
-            // Trim whitespace
-            skill.erase(0, skill.find_first_not_of(" \t"));
-            skill.erase(skill.find_last_not_of(" \t") + 1);
-            if (!skill.empty()) {
-                string normSkill = normalizeText(skill);
-                // Add the entire skill phrase as a single token
-                skillIndex[normSkill].insert(i);
-            }
-        }
-        
-        // Index title (for jobs) - use the title field directly
-        string title = dataArray[i].title;
-        title = normalizeText(title);
-        addToIndex(title, i, titleIndex);
-        
-        // Index full description
-        string description = normalizeText(dataArray[i].getText());
-        addToIndex(description, i, descriptionIndex);
-    }
-    
-    indexBuilt = true;
-    cout << "Inverted index built successfully!" << endl;
+void Array<Resume>::storeRow(RecordStore& store, int row, const Resume& resume) {
+    store.setRow(row, resume.id, "", resume.skills, resume.summary, resume.skillBits);
+}
+
+template<>
+Job Array<Job>::getItem(int index) const {
+    Job job;
+    if (!isLive(index)) return job; // default record
+    job.id = records.id(index);
+    job.title = string(records.title(index));
+    job.skills = string(records.skillText(index));
+    job.description = string(records.customText(index));
+    job.skillBits = records.skillSet(index);
+    return job;
+}
+
+template<>
+Resume Array<Resume>::getItem(int index) const {
+    Resume resume;
+    if (!isLive(index)) return resume;
+    resume.id = records.id(index);
+    resume.skills = string(records.skillText(index));
+    resume.summary = string(records.customText(index));
+    resume.skillBits = records.skillSet(index);
+    return resume;
+}
+
+template<>
+string Array<Job>::getText(int index) const {
+    string_view custom = records.customText(index);
+    return custom.empty() ? Job::describe(records.title(index), records.skillText(index)) : string(custom);
+}
+
+template<>
+string Array<Resume>::getText(int index) const {
+    string_view custom = records.customText(index);
+    return custom.empty() ? Resume::describe(records.skillText(index)) : string(custom);
+}
+
+template<>
+void Array<Job>::display(int index, string& out) const {
+    string_view title = records.title(index);
+    string_view skills = records.skillText(index);
+    out += "Job Description: ";
+    out += title;
+    out += " needed with experience in ";
+    out += skills;
+    out += ".\nTitle: ";
+    out += title;
+    out += "\nSkills: ";
+    out += skills;
+    out += "\n----------------------------------------\n";
+}
+
+template<>
+void Array<Resume>::display(int index, string& out) const {
+    string_view skills = records.skillText(index);
+    out += "Details: Experienced professional skilled in ";
+    out += skills;
+    out += ".\nSkills: ";
+    out += skills;
+    out += "\n----------------------------------------\n";
+}
+
+// Index terms of a job: skills, title words and description words
+template<>
+void Array<Job>::collectTerms(int row, DocumentTerms& terms, Arena& scratch) const {
+    // Index skills - each skill ID maps to its whole (normalized) skill phrase
+    records.skillSet(row).forEach([&](int skillId) {
+        terms.fields[FIELD_SKILL].push_back(skillDictionary.getIndexKey(skillId));
+    });
+    string_view title = records.title(row);
+    string_view text = records.customText(row);
+    if (text.empty()) text = scratch.concat({Job::TEXT_PREFIX, title, Job::TEXT_INFIX, records.skillText(row)});
+    addTokens(title, terms.fields[FIELD_TITLE], scratch);
+    addTokens(text, terms.fields[FIELD_DESCRIPTION], scratch);
 }
 
+// Index terms of a resume: skills and description words (resumes have no title)
 template<>
-void Array<Resume>::buildIndex() {
+void Array<Resume>::collectTerms(int row, DocumentTerms& terms, Arena& scratch) const {
+    records.skillSet(row).forEach([&](int skillId) {
+        terms.fields[FIELD_SKILL].push_back(skillDictionary.getIndexKey(skillId));
+    });
+    string_view text = records.customText(row);
+    if (text.empty()) text = scratch.concat({Resume::TEXT_PREFIX, records.skillText(row)});
+    addTokens(text, terms.fields[FIELD_DESCRIPTION], scratch);
+}
+
+// Bulk-build the inverted index over every live record
+template<typename T>
+void Array<T>::buildIndex() {
     if (indexBuilt) return; // Index already built
     
-    // Clear existing indexes
-    skillIndex.clear();
-    titleIndex.clear();
-    descriptionIndex.clear();
-    
-    // Build indexes for each document
-    for (int i = 0; i < size; i++) {
-        // Index skills - split by comma first to handle multi-word skills as phrases
-        string skills = dataArray[i].getSkills();
-        istringstream skillStream(skills);
-        string skill;
-        while (getline(skillStream, skill, ',')) {
-            // Trim whitespace
-            skill.erase(0, skill.find_first_not_of(" \t"));
-            skill.erase(skill.find_last_not_of(" \t") + 1);
-            if (!skill.empty()) {
-                string normSkill = normalizeText(skill);
-                // Add the entire skill phrase as a single token
-                skillIndex[normSkill].insert(i);
-            }
-        }
-        
-        // Index full description
-        string description = normalizeText(dataArray[i].getText());
-        addToIndex(description, i, descriptionIndex);
-    }
-    
+    // One scratch arena for every document: its slabs are reused once the first ones are filled
+    Arena scratch;
+    index.rebuild(getSize(), [&](int docId, DocumentTerms& terms) {
+        if (!isLive(docId)) return false;
+        scratch.reset(); // the builder has copied the previous document's terms
+        collectTerms(docId, terms, scratch);
+        return true;
+    });
     indexBuilt = true;
-    cout << "Inverted index built successfully!" << endl;
+    cout << "Inverted index built successfully!\n"; // single write: loads may run concurrently
 }
 
 // Job implementation
@@ -292,61 +393,30 @@ Job::Job(const string& csvLine) {
 
 void Job::parseFromCSV(const string& csvLine) {
     // Parse CSV line: Job_ID,Title,Skills
-    istringstream iss(csvLine);
-    string field;
-    StringArray fields;
-    
-    // Split by comma, handling quoted fields
-    bool inQuotes = false;
-    string currentField = "";
-    
-    for (char c : csvLine) {
-        if (c == '"') {
-            inQuotes = !inQuotes;
-        } else if (c == ',' && !inQuotes) {
-            fields.push_back(currentField);
-            currentField = "";
-        } else {
-            currentField += c;
-        }
+    CsvReader reader(csvLine.data(), csvLine.size());
+    CsvRecord record;
+    if (!reader.next(record)) {
+        record.fieldCount = 0;
+        record.line = string_view();
     }
-    fields.push_back(currentField); // Add the last field
-    
-    if (fields.size() >= 3) {
-        // Job_ID
-        string idStr = fields[0];
-        if (!idStr.empty() && idStr.front() == '"' && idStr.back() == '"') {
-            idStr = idStr.substr(1, idStr.length() - 2);
-        }
-        try { id = stoi(idStr); } catch (...) { id = -1; }
+    parseFromFields(record);
+}
 
-        title = fields[1];
-        skills = fields[2];
-        
-        // Clean up title (remove quotes if present)
-        if (title.front() == '"' && title.back() == '"') {
-            title = title.substr(1, title.length() - 2);
-        }
-        
-        // Clean up skills (remove quotes if present)
-        if (skills.front() == '"' && skills.back() == '"') {
-            skills = skills.substr(1, skills.length() - 2);
-        }
-        
-        // Set default values for other fields
-        description = "Job: " + title + " requiring " + skills;
-        company = "Company Not Specified";
-        location = "Location Not Specified";
-        experience_level = "Not Specified";
+// Fill the job from already split CSV fields (views into the file, quotes not yet removed)
+void Job::parseFromFields(const CsvRecord& record) {
+    if (record.fieldCount >= 3) {
+        id = record.fields[0].toInt(-1);
+        record.fields[1].materializeTo(title);
+        record.fields[2].materializeTo(skills);
+        description.clear(); // standard text
+        skillBits = skillDictionary.encode(skills);
     } else {
         // Fallback for malformed data
         id = -1;
         title = "Unknown Position";
         skills = "Not specified";
-        description = csvLine;
-        company = "Company Not Specified";
-        location = "Location Not Specified";
-        experience_level = "Not Specified";
+        skillBits.clear();
+        description.assign(record.line.data(), record.line.size());
     }
 }
 
@@ -379,87 +449,7 @@ void Job::parseFromDescription(const string& desc) {
     } else {
         skills = "Not specified";
     }
-    
-    // Set default values for other fields
-    company = "Company Not Specified";
-    location = "Location Not Specified";
-    experience_level = "Not Specified";
-}
-
-// Helper function to filter out noise words and keep only technical skills
-string Job::filterTechnicalSkills(const string& rawSkills) {
-    // List of technical skills to keep
-    string technicalSkills[] = {
-        "SQL", "Python", "Java", "JavaScript", "C++", "C#", "R", "Scala", "Go", "Rust",
-        "Power BI", "Tableau", "Excel", "Pandas", "NumPy", "Matplotlib", "Seaborn",
-        "Machine Learning", "Deep Learning", "NLP", "Computer Vision", "Statistics",
-        "TensorFlow", "PyTorch", "Keras", "Scikit-learn", "MLOps", "ML",
-        "REST APIs", "Spring Boot", "Docker", "Kubernetes", "Git", "Agile", "Scrum",
-        "System Design", "Microservices", "AWS", "Azure", "GCP", "Cloud",
-        "Data Cleaning", "Data Analysis", "Reporting", "ETL", "Data Pipeline",
-        "Product Roadmap", "User Stories", "Stakeholder Management", "Project Management",
-        "React", "Angular", "Vue", "Node.js", "Express", "Django", "Flask",
-        "MongoDB", "PostgreSQL", "MySQL", "Redis", "Elasticsearch",
-        "Linux", "Windows", "macOS", "Bash", "Shell", "DevOps", "CI/CD"
-    };
-    
-    int numSkills = sizeof(technicalSkills) / sizeof(technicalSkills[0]);
-    string filteredSkills = "";
-    
-    // Split raw skills by comma and check each one
-    istringstream iss(rawSkills);
-    string skill;
-    bool first = true;
-    
-    while (getline(iss, skill, ',')) {
-        // Trim whitespace
-        skill.erase(0, skill.find_first_not_of(" \t"));
-        skill.erase(skill.find_last_not_of(" \t") + 1);
-        
-        // Skip empty skills
-        if (skill.empty()) continue;
-        
-        // Check if it's a technical skill (exact match)
-        bool isTechnical = false;
-        for (int i = 0; i < numSkills; i++) {
-            if (skill == technicalSkills[i]) {
-                isTechnical = true;
-                break;
-            }
-        }
-        
-        // Also check for case-insensitive matches
-        if (!isTechnical) {
-            string lowerSkill = skill;
-            transform(lowerSkill.begin(), lowerSkill.end(), lowerSkill.begin(), ::tolower);
-            
-            for (int i = 0; i < numSkills; i++) {
-                string lowerTech = technicalSkills[i];
-                transform(lowerTech.begin(), lowerTech.end(), lowerTech.begin(), ::tolower);
-                
-                if (lowerSkill == lowerTech) {
-                    isTechnical = true;
-                    skill = technicalSkills[i]; // Use proper case
-                    break;
-                }
-            }
-        }
-        
-        if (isTechnical) {
-            if (!first) filteredSkills += ", ";
-            filteredSkills += skill;
-            first = false;
-        }
-    }
-    
-    return filteredSkills.empty() ? "Not specified" : filteredSkills;
-}
-
-void Job::display() const {
-    cout << "Job Description: " << title << " needed with experience in " << skills << "." << endl;
-    cout << "Title: " << title << endl;
-    cout << "Skills: " << skills << endl;
-    cout << "----------------------------------------" << endl;
+    skillBits = skillDictionary.encode(skills);
 }
 
 // Resume implementation
@@ -469,56 +459,28 @@ Resume::Resume(const string& csvLine) {
 
 void Resume::parseFromCSV(const string& csvLine) {
     // Parse CSV line: Resume_ID,Skills
-    istringstream iss(csvLine);
-    string field;
-    StringArray fields;
-    
-    // Split by comma, handling quoted fields
-    bool inQuotes = false;
-    string currentField = "";
-    
-    for (char c : csvLine) {
-        if (c == '"') {
-            inQuotes = !inQuotes;
-        } else if (c == ',' && !inQuotes) {
-            fields.push_back(currentField);
-            currentField = "";
-        } else {
-            currentField += c;
-        }
+    CsvReader reader(csvLine.data(), csvLine.size());
+    CsvRecord record;
+    if (!reader.next(record)) {
+        record.fieldCount = 0;
+        record.line = string_view();
     }
-    fields.push_back(currentField); // Add the last field
-    
-    if (fields.size() >= 2) {
-        // Resume_ID
-        string idStr = fields[0];
-        if (!idStr.empty() && idStr.front() == '"' && idStr.back() == '"') {
-            idStr = idStr.substr(1, idStr.length() - 2);
-        }
-        try { id = stoi(idStr); } catch (...) { id = -1; }
+    parseFromFields(record);
+}
 
-        skills = fields[1];
-        
-        // Clean up skills (remove quotes if present)
-        if (skills.front() == '"' && skills.back() == '"') {
-            skills = skills.substr(1, skills.length() - 2);
-        }
-        
-        // Set default values for other fields
-        summary = "Professional with skills in " + skills;
-        name = "Professional";
-        experience = "Experienced";
-        education = "Not Specified";
-        contact = "Not Provided";
+// Fill the resume from already split CSV fields (views into the file, quotes not yet removed)
+void Resume::parseFromFields(const CsvRecord& record) {
+    if (record.fieldCount >= 2) {
+        id = record.fields[0].toInt(-1);
+        record.fields[1].materializeTo(skills);
+        summary.clear(); // standard text
+        skillBits = skillDictionary.encode(skills);
     } else {
         // Fallback for malformed data
         id = -1;
         skills = "Not specified";
-        summary = csvLine;
-        name = "Professional";
-        experience = "Experienced";
-        education = "Not Specified";
-        contact = "Not Provided";
+        skillBits.clear();
+        summary.assign(record.line.data(), record.line.size());
     }
 }
 
@@ -540,262 +502,190 @@ void Resume::parseFromDescription(const string& desc) {
     } else {
         skills = "Not specified";
     }
-    
-    // Set default values for other fields
-    name = "Professional";
-    experience = "Experienced";
-    education = "Not Specified";
-    contact = "Not Provided";
-}
-
-// Helper function to filter out noise words and keep only technical skills
-string Resume::filterTechnicalSkills(const string& rawSkills) {
-    // List of technical skills to keep
-    string technicalSkills[] = {
-        "SQL", "Python", "Java", "JavaScript", "C++", "C#", "R", "Scala", "Go", "Rust",
-        "Power BI", "Tableau", "Excel", "Pandas", "NumPy", "Matplotlib", "Seaborn",
-        "Machine Learning", "Deep Learning", "NLP", "Computer Vision", "Statistics",
-        "TensorFlow", "PyTorch", "Keras", "Scikit-learn", "MLOps", "ML",
-        "REST APIs", "Spring Boot", "Docker", "Kubernetes", "Git", "Agile", "Scrum",
-        "System Design", "Microservices", "AWS", "Azure", "GCP", "Cloud",
-        "Data Cleaning", "Data Analysis", "Reporting", "ETL", "Data Pipeline",
-        "Product Roadmap", "User Stories", "Stakeholder Management", "Project Management",
-        "React", "Angular", "Vue", "Node.js", "Express", "Django", "Flask",
-        "MongoDB", "PostgreSQL", "MySQL", "Redis", "Elasticsearch",
-        "Linux", "Windows", "macOS", "Bash", "Shell", "DevOps", "CI/CD"
-    };
-    
-    int numSkills = sizeof(technicalSkills) / sizeof(technicalSkills[0]);
-    string filteredSkills = "";
-    
-    // Split raw skills by comma and check each one
-    istringstream iss(rawSkills);
-    string skill;
-    bool first = true;
-    
-    while (getline(iss, skill, ',')) {
-        // Trim whitespace
-        skill.erase(0, skill.find_first_not_of(" \t"));
-        skill.erase(skill.find_last_not_of(" \t") + 1);
-        
-        // Skip empty skills
-        if (skill.empty()) continue;
-        
-        // Check if it's a technical skill (exact match)
-        bool isTechnical = false;
-        for (int i = 0; i < numSkills; i++) {
-            if (skill == technicalSkills[i]) {
-                isTechnical = true;
-                break;
-            }
-        }
-        
-        // Also check for case-insensitive matches
-        if (!isTechnical) {
-            string lowerSkill = skill;
-            transform(lowerSkill.begin(), lowerSkill.end(), lowerSkill.begin(), ::tolower);
-            
-            for (int i = 0; i < numSkills; i++) {
-                string lowerTech = technicalSkills[i];
-                transform(lowerTech.begin(), lowerTech.end(), lowerTech.begin(), ::tolower);
-                
-                if (lowerSkill == lowerTech) {
-                    isTechnical = true;
-                    skill = technicalSkills[i]; // Use proper case
-                    break;
-                }
-            }
-        }
-        
-        if (isTechnical) {
-            if (!first) filteredSkills += ", ";
-            filteredSkills += skill;
-            first = false;
-        }
-    }
-    
-    return filteredSkills.empty() ? "Not specified" : filteredSkills;
-}
-
-void Resume::display() const {
-    cout << "Details: " << "Experienced professional skilled in " << skills << "." << endl;
-    cout << "Skills: " << skills << endl;
-    cout << "----------------------------------------" << endl;
+    skillBits = skillDictionary.encode(skills);
 }
 
 // Template Array implementation
 template<typename T>
 Array<T>::Array(int initialCapacity) {
-    capacity = initialCapacity;
-    size = 0;
-    dataArray = new T[capacity];
+    records.reserve(initialCapacity);
+    deletedCount = 0;
     indexBuilt = false;
 }
 
 // Destructor
 template<typename T>
 Array<T>::~Array() {
-    delete[] dataArray;
-}
-
-// Resize (double the capacity when full)
-template<typename T>
-void Array<T>::resize() {
-    int newCapacity = capacity * 2;
-    T* newArray = new T[newCapacity];
-
-    for (int i = 0; i < size; i++) {
-        newArray[i] = dataArray[i];
-    }
-
-    delete[] dataArray;
-    dataArray = newArray;
-    capacity = newCapacity;
 }
 
 // Normalize text: lowercase + trim + remove punctuation
 template<typename T>
 string Array<T>::normalizeText(const string& text) const {
-    string normalized = text;
-
-    // Convert to lowercase
-    transform(normalized.begin(), normalized.end(), normalized.begin(),
-              [](unsigned char c){ return tolower(c); });
-
-    // Remove punctuation but keep spaces for tokenization
-    normalized.erase(remove_if(normalized.begin(), normalized.end(),
-              [](unsigned char c){ return ispunct(c) && c != ' '; }), normalized.end());
-
-    // Trim leading/trailing spaces
-    size_t start = normalized.find_first_not_of(" \t\n\r");
-    size_t end = normalized.find_last_not_of(" \t\n\r");
-    if (start == string::npos) return "";
-    return normalized.substr(start, end - start + 1);
+    return normalizeKey(text);
 }
 
 // Insert new item
 template<typename T>
 bool Array<T>::insert(const T& item) {
-    if (size == capacity) {
-        resize();
+    int row = records.addRow();
+    storeRow(records, row, item);
+    if (indexBuilt) {
+        DocumentTerms terms;
+        collectTerms(row, terms, termScratch);
+        index.addDocument(row, terms);
+        termScratch.reset();
     }
-    dataArray[size++] = item;
     return true;
 }
 
-// Remove item at index
+// Replace a live item in place (same document ID)
 template<typename T>
-bool Array<T>::remove(int index) {
-    if (index < 0 || index >= size) return false;
-
-    for (int i = index; i < size - 1; i++) {
-        dataArray[i] = dataArray[i + 1];
+bool Array<T>::update(int index, const T& item) {
+    if (!isLive(index)) return false;
+    DocumentTerms terms;
+    if (indexBuilt) {
+        collectTerms(index, terms, termScratch);
+        this->index.removeDocument(index, terms);
+    }
+    storeRow(records, index, item);
+    if (indexBuilt) {
+        terms.clear();
+        collectTerms(index, terms, termScratch);
+        this->index.addDocument(index, terms);
+        termScratch.reset();
     }
-    size--;
     return true;
 }
 
-// (search removed as unused)
-
-// Get item at specific index
+// Remove item at index: the slot becomes a tombstone, so no other ID moves
 template<typename T>
-T Array<T>::getItem(int index) const {
-    if (index < 0 || index >= size) {
-        return T(); // return default constructed object
+bool Array<T>::remove(int index) {
+    if (!isLive(index)) return false;
+    if (indexBuilt) {
+        DocumentTerms terms;
+        collectTerms(index, terms, termScratch);
+        this->index.removeDocument(index, terms);
+        termScratch.reset();
     }
-    return dataArray[index];
+    if (index >= (int)tombstones.size()) tombstones.resize(index + 1, 0);
+    tombstones[index] = 1;
+    deletedCount++;
+    records.clearRow(index); // an empty skill row never matches
+    return true;
 }
 
-// Load from CSV file
+// Remove every item and drop the indexes
 template<typename T>
-bool Array<T>::loadFromCSV(const string& filename) {
-    ifstream file(filename);
-    if (!file.is_open()) {
+void Array<T>::clear() {
+    records.clear();
+    tombstones.clear();
+    deletedCount = 0;
+    index.clear();
+    indexBuilt = false;
+}
+
+// Load from CSV file (memory-mapped, records parsed in place as views into the mapping)
+// Large files are split into quote-aware byte ranges that are parsed on separate threads
+template<typename T>
+bool Array<T>::loadFromCSV(const string& filename, int numThreads) {
+    MappedFile file;
+    if (!file.open(filename)) {
         cerr << "Error: Unable to open file " << filename << endl;
         return false;
     }
 
-    string line;
-    bool firstLine = true;
-    while (getline(file, line)) {
-        if (firstLine) {
-            firstLine = false; // Skip header
-            continue;
-        }
-        
-        if (!line.empty()) {
-            T item(line);
-            insert(item);
+    int chunks = csvChunkCount(file.size(), numThreads);
+    int firstNew = getSize();
+    vector<RecordStore> chunkStores(chunks - 1);
+    
+    // Parse records of range c straight into columns: range 0 into this array, range c > 0 into
+    // chunkStores[c - 1] (the first record of the file is the header). One record object per
+    // range is reused, so its strings stop allocating once they have grown.
+    auto parseChunk = [&](int c, const char* start, const char* stop) {
+        RecordStore& store = c == 0 ? records : chunkStores[c - 1];
+        // Sized from the range: at most one record per line, and never more text than the range holds
+        store.reserve(store.size() + (int)countCsvLines(start, stop), stop - start);
+        CsvReader reader(start, stop - start);
+        CsvRecord record;
+        T item;
+        bool skipHeader = (c == 0);
+        while (reader.next(record)) {
+            if (skipHeader) {
+                skipHeader = false; // Skip header
+                continue;
+            }
+            if (!record.isBlank()) {
+                item.parseFromFields(record);
+                storeRow(store, store.addRow(), item);
+            }
         }
+    };
+    
+    if (chunks == 1) {
+        parseChunk(0, file.data(), file.data() + file.size());
+    } else {
+        WorkStealingPool pool(chunks);
+        vector<const char*> starts = findCsvChunkStarts(file.data(), file.size(), chunks, pool);
+        pool.parallelFor(0, chunks, 1, [&](int first, int last, int) {
+            for (int c = first; c < last; c++) {
+                parseChunk(c, starts[c], starts[c + 1]);
+            }
+        });
+    }
+
+    // Append the other ranges in original row order
+    for (RecordStore& chunk : chunkStores) {
+        records.append(chunk);
+        chunk = RecordStore(); // release the chunk
     }
 
     file.close();
     
-    // Build inverted index after loading data
-    if (size > 0) {
+    // Build inverted index after loading data (or add the new records to an existing one)
+    if (indexBuilt) {
+        DocumentTerms terms;
+        for (int i = firstNew; i < getSize(); i++) {
+            terms.clear();
+            collectTerms(i, terms, termScratch);
+            index.addDocument(i, terms);
+            termScratch.reset();
+        }
+    } else if (getSize() > 0) {
         buildIndex();
     }
     
     return true;
 }
 
-// Quick Sort implementation for sorting matches by score (descending order)
+// Snapshot section: record count, records, tombstones, then the compacted index
 template<typename T>
-void Array<T>::quickSort(Match* matches, int low, int high) const {
-    if (low < high) {
-        int pivotIndex = partition(matches, low, high);
-        quickSort(matches, low, pivotIndex - 1);
-        quickSort(matches, pivotIndex + 1, high);
-    }
+void Array<T>::writeSnapshot(SnapshotWriter& out) {
+    buildIndex();
+    records.writeTo(out);
+    out.putArray(tombstones);
+    index.writeTo(out);
 }
 
-// Partition function for Quick Sort
 template<typename T>
-int Array<T>::partition(Match* matches, int low, int high) const {
-    int pivot = matches[high].score;
-    int i = low - 1;
-    
-    for (int j = low; j < high; j++) {
-        // Sort in descending order (highest scores first)
-        if (matches[j].score >= pivot) {
-            i++;
-            swap(matches[i], matches[j]);
-        }
-    }
-    swap(matches[i + 1], matches[high]);
-    return i + 1;
-}
+bool Array<T>::readSnapshot(SnapshotReader& in) {
+    clear();
+    if (!records.readFrom(in)) return false;
 
-// Top-K optimization: Get only the top K results without sorting entire array
-template<typename T>
-void Array<T>::getTopKMatches(Match* matches, int matchCount, int k, Match* topK) const {
-    if (k >= matchCount) {
-        // If k >= matchCount, just copy all matches
-        for (int i = 0; i < matchCount; i++) {
-            topK[i] = matches[i];
-        }
-        return;
-    }
-    
-    // Use partial sort to get top K elements
-    // This is more efficient than sorting the entire array
-    for (int i = 0; i < k; i++) {
-        int maxIndex = i;
-        for (int j = i + 1; j < matchCount; j++) {
-            if (matches[j].score > matches[maxIndex].score) {
-                maxIndex = j;
-            }
-        }
-        if (maxIndex != i) {
-            swap(matches[i], matches[maxIndex]);
-        }
-        topK[i] = matches[i];
+    in.getArray(tombstones);
+    deletedCount = (int)count_if(tombstones.begin(), tombstones.end(), [](uint8_t removed) { return removed != 0; });
+    bool loaded = in.ok() && tombstones.size() <= (size_t)getSize() && index.readFrom(in);
+    if (!loaded) {
+        clear();
+        return false;
     }
+    indexBuilt = true;
+    return true;
 }
 
-// Display multiple matches with scores using Inverted Index
+// Keyword / skill search over the inverted index: the best maxResults matches, best first.
+// candidateCount (optional) receives the number of documents the index returned.
 template<typename T>
-void Array<T>::displayMatches(const string& keyword, int maxResults) const {
+vector<Match> Array<T>::searchBySkills(const string& keyword, int maxResults, int* candidateCount, PruningStats* pruning) const {
     // Build index if not already built
     if (!indexBuilt) {
         cout << "Building inverted index for fast search..." << endl;
@@ -803,216 +693,273 @@ void Array<T>::displayMatches(const string& keyword, int maxResults) const {
     }
     
     // Use inverted index for fast search
-    set<int> candidateIds = booleanSearch(keyword);
+    DocIdList candidateIds = booleanSearch(keyword);
+    if (candidateCount != nullptr) *candidateCount = (int)candidateIds.size();
+    if (pruning != nullptr) *pruning = PruningStats{0, 0};
     
     if (candidateIds.empty()) {
-        cout << "No matches found for '" << keyword << "'" << endl;
-        return;
+        return vector<Match>();
+    }
+    
+    // Parse the query once: each search term becomes a mask of dictionary skills
+    // whose name contains it, so scoring a candidate needs no string work on its skills
+    StringArray searchTerms;
+    bool multiSkill = keyword.find(',') != string::npos; // check BEFORE normalizing
+    if (multiSkill) {
+        istringstream iss(keyword);
+        string skill;
+        while (getline(iss, skill, ',')) {
+            skill.erase(0, skill.find_first_not_of(" \t"));
+            if (!skill.empty() && skill[0] == '-') continue; // excluded skills are not scored
+            string normSkill = normalizeText(skill);
+            if (!normSkill.empty()) {
+                searchTerms.push_back(move(normSkill));
+            }
+        }
+    } else {
+        searchTerms.push_back(normalizeText(keyword));
+    }
+    
+    SkillSet* termMasks = new SkillSet[searchTerms.size()];
+    for (int t = 0; t < searchTerms.size(); t++) {
+        termMasks[t] = skillDictionary.skillsContaining(searchTerms[t]);
     }
     
-    // Create array to store scores and indices for candidates only
-    Match* matches = new Match[candidateIds.size()];
-    int matchCount = 0;
+    // Word overlaps are only scored for single-term searches
+    StringArray overlapWords;
+    if (!multiSkill) {
+        istringstream iss(searchTerms[0]);
+        string word;
+        while (iss >> word) {
+            overlapWords.emplace_back(word);
+        }
+    }
+    SkillSet* wordMasks = new SkillSet[overlapWords.size()];
+    for (int w = 0; w < overlapWords.size(); w++) {
+        wordMasks[w] = skillDictionary.skillsContaining(overlapWords[w]);
+    }
     
-    // Only process candidates from inverted index (much faster!)
-    for (int docId : candidateIds) {
+    // Score only the candidates from the inverted index, keeping the best maxResults
+    auto scoreCandidate = [&](int docId) {
         int score = 0;
+        SkillSet docSkills = records.skillSet(docId);
+        string normDesc = normalizeText(getText(docId));
         
-        string normSkills = normalizeText(dataArray[docId].getSkills());
-        string normDesc = normalizeText(dataArray[docId].getText());
-        
-        // Handle comma-separated skills properly (check BEFORE normalizing)
-        if (keyword.find(',') != string::npos) {
-            // Parse comma-separated skills
-            StringArray searchSkills;
-            istringstream iss(keyword);
-            string skill;
-            while (getline(iss, skill, ',')) {
-                // Trim whitespace
-                skill.erase(0, skill.find_first_not_of(" \t"));
-                skill.erase(skill.find_last_not_of(" \t") + 1);
-                if (!skill.empty()) {
-                    // Normalize each skill before searching
-                    searchSkills.push_back(normalizeText(skill));
-                }
+        // Score based on individual skill matches
+        for (int t = 0; t < searchTerms.size(); t++) {
+            if (docSkills.countCommon(termMasks[t]) > 0) {
+                score += 10; // Each matching skill adds 10 points
             }
-            
-            // Score based on individual skill matches
-            for (const string& searchSkill : searchSkills) {
-                if (normSkills.find(searchSkill) != string::npos) {
-                    score += 10; // Each matching skill adds 10 points
-                }
-                if (normDesc.find(searchSkill) != string::npos) {
-                    score += 5; // Each matching skill in description adds 5 points
-                }
+            if (normDesc.find(searchTerms[t]) != string::npos) {
+                score += 5; // Each matching skill in description adds 5 points
             }
-        } else {
-            // Single skill search
-            string normKey = normalizeText(keyword);
-        if (normSkills.find(normKey) != string::npos) {
-            score += 10;
-        }
-        if (normDesc.find(normKey) != string::npos) {
-            score += 5;
         }
         
-            // Count word overlaps for single term
-        istringstream iss(normKey);
-        string word;
-        while (iss >> word) {
-            if (normSkills.find(word) != string::npos) {
+        // Count word overlaps for single term
+        for (int w = 0; w < overlapWords.size(); w++) {
+            if (docSkills.countCommon(wordMasks[w]) > 0) {
                 score += 2;
-                }
             }
         }
-        
-        if (score > 0) {
-            matches[matchCount].index = docId;
-            matches[matchCount].score = score;
-            matchCount++;
+        return score;
+    };
+    TopKCollector topK(maxResults);
+    if ((int)candidateIds.size() <= maxResults) {
+        collectTopMatches(candidateIds, scoreCandidate, topK); // every candidate is shown anyway
+        if (pruning != nullptr) pruning->documentsScored = (long long)candidateIds.size();
+    } else {
+        // MaxScore pruning: each skill term / overlap word becomes a clause over the skill index,
+        // and the description terms (substring matches) one clause over all candidates
+        RoaringBitmap candidateBitmap = RoaringBitmap::fromSorted(candidateIds.begin(), candidateIds.end());
+        auto skillClause = [&](const SkillSet& mask, int points) {
+            vector<string_view> keys;
+            mask.forEach([&](int skillId) { keys.push_back(skillDictionary.getIndexKey(skillId)); });
+            ScoredClause clause;
+            clause.docs = RoaringBitmap::andOf(index.lookupAnySkill(keys), candidateBitmap).toDocIdList();
+            clause.maxScore = points;
+            return clause;
+        };
+        vector<ScoredClause> clauses;
+        for (int t = 0; t < searchTerms.size(); t++) {
+            clauses.push_back(skillClause(termMasks[t], 10));
+        }
+        for (int w = 0; w < overlapWords.size(); w++) {
+            clauses.push_back(skillClause(wordMasks[w], 2));
         }
+        clauses.push_back(ScoredClause{candidateIds, 5 * searchTerms.size()});
+        PruningStats stats = maxScoreTopK(clauses, scoreCandidate, topK);
+        if (pruning != nullptr) *pruning = stats;
     }
     
-    // Top-K optimization: Only get the top results we need to display
-    int resultsToShow = min(maxResults, matchCount);
-    Match* topMatches = new Match[resultsToShow];
-    
-    if (matchCount > 0) {
-        getTopKMatches(matches, matchCount, resultsToShow, topMatches);
+    delete[] termMasks;
+    delete[] wordMasks;
+    return topK.sortedResults();
+}
+
+// Keyword / skill search, reported to sink
+template<typename T>
+void Array<T>::displayMatches(const string& keyword, int maxResults, ResultSink& sink) const {
+    int candidateCount = 0;
+    PruningStats pruning;
+    vector<Match> topMatches = searchBySkills(keyword, maxResults, &candidateCount, &pruning);
+    
+    if (candidateCount == 0) {
+        sink.summary("No matches found for '" + keyword + "'\n");
+        sink.flush();
+        return;
     }
+    int resultsToShow = (int)topMatches.size();
     
     // Display top matches
-    cout << "\n=== Top " << resultsToShow << " Matches for '" << keyword << "' ===" << endl;
+    sink.summary("\n=== Top " + to_string(resultsToShow) + " Matches for '" + keyword + "' ===\n");
+    string text;
     for (int i = 0; i < resultsToShow; i++) {
-        cout << "\nMatch " << (i + 1) << " (Score: " << topMatches[i].score << "):" << endl;
-        cout << "ID: " << topMatches[i].index << endl;
-        dataArray[topMatches[i].index].display();
+        text += "\nMatch " + to_string(i + 1) + " (Score: " + to_string(topMatches[i].score) + "):\n";
+        text += "ID: " + to_string(topMatches[i].index) + "\n";
+        display(topMatches[i].index, text);
     }
+    sink.result(text);
     
-    delete[] topMatches;
-    
-    if (matchCount == 0) {
-        cout << "No matches found for '" << keyword << "'" << endl;
+    if (topMatches.empty()) {
+        sink.summary("No matches found for '" + keyword + "'\n");
     }
-    
-    delete[] matches;
+    string work = "\nFully scored " + to_string(pruning.documentsScored) + " of " + to_string(candidateCount) + " candidates";
+    if (pruning.postingsVisited > 0) work += " (MaxScore pruning, " + to_string(pruning.postingsVisited) + " postings visited)";
+    sink.summary(work + "\n");
+    sink.flush();
 }
 
 
-// Add text to inverted index
+// Append the indexable words of a text to terms: the text is normalized (punctuation dropped,
+// lowercased) into the scratch arena and split on whitespace there, keeping words of two or more
+// characters - the same words as tokenize(normalizeText(text)), without a string per word
 template<typename T>
-void Array<T>::addToIndex(const string& text, int docId, map<string, set<int>>& index) {
-    StringArray tokens = tokenize(text);
-    for (const string& token : tokens) {
-        if (token.length() > 1) { // Skip single characters
-            index[token].insert(docId);
+void Array<T>::addTokens(string_view text, vector<string_view>& terms, Arena& scratch) const {
+    char* normalized = (char*)scratch.allocate(text.size(), 1);
+    size_t length = 0;
+    for (unsigned char c : text) {
+        if (!ispunct(c)) normalized[length++] = (char)tolower(c);
+    }
+    size_t pos = 0;
+    while (pos < length) {
+        while (pos < length && isspace((unsigned char)normalized[pos])) pos++;
+        size_t start = pos;
+        while (pos < length && !isspace((unsigned char)normalized[pos])) pos++;
+        if (pos - start > 1) { // Skip single characters
+            terms.push_back(string_view(normalized + start, pos - start));
         }
     }
 }
 
-// Search in a specific index
+// Search one field of the index
 template<typename T>
-set<int> Array<T>::searchIndex(const string& keyword, const map<string, set<int>>& index) const {
+DocIdList Array<T>::searchIndex(const string& keyword, IndexField field) const {
     string normKey = normalizeText(keyword);
     
-    // For skill index, treat the keyword as a phrase (don't tokenize)
-    if (&index == &skillIndex) {
-        auto it = index.find(normKey);
-        if (it != index.end()) {
-            return it->second;
-        }
-        return set<int>();
-    }
-    
-    // For other indexes, tokenize and do AND search
+    // Tokenize and do AND search (galloping / SIMD block intersection kernels)
     StringArray tokens = tokenize(normKey);
-    
-    set<int> result;
-    for (const string& token : tokens) {
-        auto it = index.find(token);
-        if (it != index.end()) {
-            if (result.empty()) {
-                result = it->second; // First token
-            } else {
-                // Intersection for AND operation
-                set<int> intersection;
-                set_intersection(result.begin(), result.end(),
-                               it->second.begin(), it->second.end(),
-                               inserter(intersection, intersection.begin()));
-                result = intersection;
-            }
-        } else {
-            return set<int>(); // No matches if any token not found
-        }
-    }
-    return result;
+    return index.lookupAll(field, vector<string>(tokens.begin(), tokens.end()));
+}
+
+// Look up a whole skill phrase in the skill index (the phrase is not tokenized)
+template<typename T>
+RoaringBitmap Array<T>::searchSkill(const string& skill) const {
+    // A known skill name or alias is looked up under its skill's index key
+    int skillId = skillDictionary.findSkill(skill);
+    return index.lookupSkill(skillId >= 0 ? skillDictionary.getIndexKey(skillId) : normalizeText(skill));
 }
 
-// Boolean search with AND/OR operations
+// Boolean search with AND/OR/NOT operations, evaluated as Roaring bitmap operations
 template<typename T>
-set<int> Array<T>::booleanSearch(const string& query) const {
+DocIdList Array<T>::booleanSearch(const string& query) const {
     if (!indexBuilt) {
         cout << "Index not built! Building now..." << endl;
         const_cast<Array<T>*>(this)->buildIndex();
     }
     
     // Check for comma-separated skills BEFORE normalizing (comma will be removed by normalize)
+    // Plain skills are OR'ed, "+skill" is required (AND) and "-skill" is excluded (AND NOT)
     if (query.find(',') != string::npos) {
-        StringArray skills;
+        vector<RoaringBitmap> anyOf, allOf, noneOf;
         istringstream iss(query);
         string skill;
         while (getline(iss, skill, ',')) {
             // Trim whitespace
             skill.erase(0, skill.find_first_not_of(" \t"));
             skill.erase(skill.find_last_not_of(" \t") + 1);
-            if (!skill.empty()) {
-                skills.push_back(skill);
-            }
+            if (skill.empty()) continue;
+            
+            if (skill[0] == '+') allOf.push_back(searchSkill(skill.substr(1)));
+            else if (skill[0] == '-') noneOf.push_back(searchSkill(skill.substr(1)));
+            else anyOf.push_back(searchSkill(skill));
         }
         
-        if (skills.empty()) {
-            return set<int>();
+        if (anyOf.empty() && allOf.empty()) {
+            return DocIdList();
         }
         
-        // Start with first skill
-        set<int> result = searchIndex(skills[0], skillIndex);
-        
-        // Union with remaining skills (OR operation)
-        for (int i = 1; i < skills.size(); i++) {
-            set<int> skillResults = searchIndex(skills[i], skillIndex);
-            result.insert(skillResults.begin(), skillResults.end());
+        // Union of every optional skill (word-level OR), then required and excluded skills
+        RoaringBitmap result;
+        size_t firstRequired = 0;
+        if (!anyOf.empty()) {
+            vector<const RoaringBitmap*> optional;
+            for (const RoaringBitmap& bitmap : anyOf) optional.push_back(&bitmap);
+            result = RoaringBitmap::orMany(optional);
+        } else {
+            result = allOf[0];
+            firstRequired = 1;
         }
-        
-        return result;
+        for (size_t i = firstRequired; i < allOf.size(); i++) {
+            result = RoaringBitmap::andOf(result, allOf[i]);
+        }
+        for (const RoaringBitmap& excluded : noneOf) {
+            result = RoaringBitmap::andNotOf(result, excluded);
+        }
+        return result.toDocIdList();
     }
     
     string normQuery = normalizeText(query);
     
-    // Check for OR operation
-    if (normQuery.find(" or ") != string::npos) {
-        StringArray orTerms;
-        istringstream iss(normQuery);
-        string term;
-        while (getline(iss, term, '|')) {
-            if (term.find(" or ") != string::npos) {
-                size_t pos = term.find(" or ");
-                orTerms.push_back(term.substr(0, pos));
-                orTerms.push_back(term.substr(pos + 4));
-            } else {
-                orTerms.push_back(term);
-            }
+    // Split text on a keyword such as " or "
+    auto splitOn = [](const string& text, const string& separator) {
+        StringArray parts;
+        size_t start = 0;
+        while (true) {
+            size_t pos = text.find(separator, start);
+            string part = text.substr(start, pos == string::npos ? string::npos : pos - start);
+            if (!part.empty()) parts.push_back(move(part));
+            if (pos == string::npos) break;
+            start = pos + separator.size();
         }
-        
-        set<int> result;
-        for (const string& term : orTerms) {
-            set<int> termResults = searchIndex(term, skillIndex);
-            result.insert(termResults.begin(), termResults.end());
+        return parts;
+    };
+    
+    // "a or b" -> OR of groups, "a and b" -> AND inside a group, "a not b" -> a AND NOT b
+    // (a single term without operators is looked up as one skill phrase)
+    StringArray orGroups = splitOn(normQuery, " or ");
+    vector<RoaringBitmap> groupResults;
+    for (const string& group : orGroups) {
+        StringArray conjuncts = splitOn(group, " and ");
+        RoaringBitmap groupResult;
+        bool firstConjunct = true;
+        for (const string& conjunct : conjuncts) {
+            StringArray parts = splitOn(conjunct, " not ");
+            if (parts.empty()) continue;
+            RoaringBitmap term = searchSkill(parts[0]);
+            for (int i = 1; i < parts.size(); i++) {
+                term = RoaringBitmap::andNotOf(term, searchSkill(parts[i]));
+            }
+            groupResult = firstConjunct ? term : RoaringBitmap::andOf(groupResult, term);
+            firstConjunct = false;
         }
-        return result;
+        groupResults.push_back(groupResult);
     }
     
-    // Default AND search for single term
-    return searchIndex(normQuery, skillIndex);
+    vector<const RoaringBitmap*> groups;
+    for (const RoaringBitmap& groupResult : groupResults) {
+        groups.push_back(&groupResult);
+    }
+    return RoaringBitmap::orMany(groups).toDocIdList();
 }
 
 // Tokenize text into words
@@ -1027,178 +974,451 @@ StringArray Array<T>::tokenize(const string& text) const {
         word.erase(remove_if(word.begin(), word.end(), ::ispunct), word.end());
         if (!word.empty()) {
             transform(word.begin(), word.end(), word.begin(), ::tolower);
-            tokens.push_back(word);
+            tokens.emplace_back(word);
         }
     }
     
     return tokens;
 }
 
-// Find candidate resumes using inverted index for a given job skills string
-// This function is only available for Job arrays
-template<>
-set<int> Array<Job>::findCandidateResumes(const string& jobSkills) const {
+// Records sharing at least one skill with the given set (OR of the skill postings)
+template<typename T>
+RoaringBitmap Array<T>::findSkillCandidates(const SkillSet& skills) const {
     if (!indexBuilt) {
         cout << "Index not built! Building now..." << endl;
-        const_cast<Array<Job>*>(this)->buildIndex();
+        const_cast<Array<T>*>(this)->buildIndex();
     }
     
-    // Use boolean search to find resumes that match the job skills
-    return booleanSearch(jobSkills);
+    vector<string_view> keys;
+    skills.forEach([&](int skillId) { keys.push_back(skillDictionary.getIndexKey(skillId)); });
+    return index.lookupAnySkill(keys);
 }
 
-// Optimized function to find best matches for each job using all advanced algorithms
-// This function is only available for Job arrays
-template<>
-void Array<Job>::findBestMatchesForJobs(const Array<Resume>& resumeStorage, int maxJobsToShow) const {
-    if (!indexBuilt) {
-        cout << "Building inverted index for optimized matching..." << endl;
-        const_cast<Array<Job>*>(this)->buildIndex();
+// Wording of one matching direction
+struct MatchLabels {
+    const char* title;          // e.g. "Job-Resume"
+    const char* queryNoun;      // plural, e.g. "jobs"
+    const char* queryNounSingular;
+    const char* targetNoun;     // plural, e.g. "resumes"
+    const char* targetIdLabel;  // e.g. "Resume ID"
+};
+
+// Per-thread buffers of CandidateScorer::scoreQuery()
+struct CandidateScratch {
+    vector<uint16_t> counts;        // popcounts of one query against every target row
+    WeightedDotTable dotTable;      // the query's weighted dot products
+};
+
+// Scores query rows against a target collection without building a score matrix: only targets
+// sharing at least one skill with a query get a model score. They come from the target
+// collection's skill index, or from a SIMD popcount row scan when the query's skills may cover
+// 1/INDEX_CANDIDATE_RATIO or more of the targets (the scan costs a few times less per pair than
+// gathering candidates, so the index only pays for sparse queries). Safe to share across threads.
+template<typename U>
+class CandidateScorer {
+private:
+    static constexpr int INDEX_CANDIDATE_RATIO = 8;
+
+    const Array<U>& targets;
+    const ScoringEngine& engine;
+    const SkillMatrix& targetMatrix;    // the target collection's skill column
+    vector<uint32_t> targetInverseNorms;
+    vector<int> skillFrequency;     // targets per skill, bounds a query's candidate count
+    bool flatModel;
+
+public:
+    CandidateScorer(const Array<U>& targetStorage, const ScoringEngine& scoringEngine)
+        : targets(targetStorage), engine(scoringEngine), targetMatrix(targetStorage.getSkillMatrix()),
+          skillFrequency(MAX_SKILLS, 0) {
+        const_cast<Array<U>&>(targets).buildIndex();
+        targetInverseNorms = scoringModel.inverseNorms(targetMatrix);
+        flatModel = scoringModel.getMode() == ScoringModel::MODEL_FLAT;
+        for (int r = 0; r < targetMatrix.getRows(); r++) {
+            for (int w = 0; w < SKILL_WORDS; w++) {
+                for (uint64_t bits = targetMatrix.row(r)[w]; bits; bits &= bits - 1) {
+                    skillFrequency[w * 64 + countTrailingZeros64(bits)]++;
+                }
+            }
+        }
     }
+
+    int getTargetRows() const { return targetMatrix.getRows(); }
+
+    // Call visit(targetRow, pairScore) for every target scoring above zero, in row order.
+    // scratch is a per-thread buffer; returns the number of pairs scored.
+    template<typename Visit>
+    long long scoreQuery(const uint64_t* query, CandidateScratch& scratch, Visit visit) const {
+        SkillSet querySkills;
+        for (int w = 0; w < SKILL_WORDS; w++) querySkills.words[w] = query[w];
+        if (querySkills.count() == 0) return 0; // removed record, or no whitelisted skills
+
+        int targetRows = targetMatrix.getRows();
+        long long candidateBound = 0;
+        querySkills.forEach([&](int skillId) { candidateBound += skillFrequency[skillId]; });
+        if (candidateBound * INDEX_CANDIDATE_RATIO >= targetRows) {
+            // SIMD popcounts find the targets sharing a skill (and are the flat score); the
+            // weighted score of those targets comes from the query's dot product table
+            vector<uint16_t>& counts = scratch.counts;
+            counts.resize(targetRows > 0 ? targetRows : 1);
+            engine.scoreRow(query, targetMatrix, counts.data());
+            if (!flatModel) scoringModel.buildDotTable(query, scratch.dotTable);
+            // Visit the sharing targets of each 64-row block through a bitmask, which keeps the
+            // mostly unpredictable "shares a skill" test out of the branches
+            for (int first = 0; first < targetRows; first += 64) {
+                int blockRows = min(64, targetRows - first);
+                uint64_t sharing = 0;
+                for (int k = 0; k < blockRows; k++) sharing |= (uint64_t)(counts[first + k] != 0) << k;
+                for (; sharing; sharing &= sharing - 1) {
+                    int r = first + countTrailingZeros64(sharing);
+                    int64_t score = flatModel ? counts[r]
+                                              : scoringModel.weightedScore(scratch.dotTable.dot(targetMatrix.row(r)), targetInverseNorms[r]);
+                    if (score > 0) visit(r, score);
+                }
+            }
+            return targetRows;
+        }
+        DocIdList candidateRows = targets.findSkillCandidates(querySkills).toDocIdList();
+        for (int r : candidateRows) {
+            int64_t score = scoringModel.pairScore(query, targetMatrix.row(r), targetInverseNorms[r]);
+            if (score > 0) visit(r, score);
+        }
+        return (long long)candidateRows.size();
+    }
+};
+
+// Queries per matcher work chunk
+const int MATCH_QUERIES_PER_CHUNK = 64;
+
+// Best-scoring targets of every query row in [0, queryCount) (candidates from CandidateScorer);
+// results[q] belongs to query row q. Queries are split into chunks scheduled on the pool, and
+// pairsScored receives the number of query/target pairs that were scored.
+template<typename Q, typename U>
+vector<BestMatch> computeBestTargets(const Array<Q>& queries, int queryCount, const Array<U>& targets,
+                                     const ScoringEngine& engine, WorkStealingPool& pool, long long& pairsScored) {
+    const SkillMatrix& queryMatrix = queries.getSkillMatrix();
+    CandidateScorer<U> scorer(targets, engine);
+    
+    vector<BestMatch> results(queryCount);
+    vector<long long> workerPairs(pool.getThreadCount(), 0);
+    pool.parallelFor(0, queryCount, MATCH_QUERIES_PER_CHUNK, [&](int firstQuery, int lastQuery, int workerId) {
+        CandidateScratch scratch;
+        for (int q = firstQuery; q < lastQuery; q++) {
+            BestMatch& result = results[q];
+            result.reset();
+            workerPairs[workerId] += scorer.scoreQuery(queryMatrix.row(q), scratch, [&](int row, int64_t score) {
+                result.add(row, score);
+            });
+        }
+    });
     
-    cout << "\n=== Optimized Job-Resume Matching ===" << endl;
-    cout << "Using: Inverted Index + Boolean Search + Quick Sort + Top-K" << endl;
-    cout << "Processing " << min(maxJobsToShow, size) << " jobs..." << endl;
-    cout << "==========================================\n";
+    pairsScored = 0;
+    for (long long pairs : workerPairs) pairsScored += pairs;
+    return results;
+}
+
+// Shared core of both matching directions: the best targets of each live query record in
+// [0, queryCount), reported to sink in query order followed by timing statistics. Result blocks
+// are formatted in parallel, one buffer per chunk of queries. numThreads <= 0 = all cores.
+// formatQuery(i, out) appends the header lines of query i.
+template<typename Q, typename U, typename FormatQuery>
+void matchBestTargets(const Array<Q>& queries, int queryCount, const Array<U>& targets, int numThreads,
+                      const MatchLabels& labels, ResultSink& sink, FormatQuery formatQuery) {
+    ScoringEngine engine;
+    WorkStealingPool pool(numThreads);
+    
+    ostringstream header;
+    header << "\n=== Optimized " << labels.title << " Matching ===" << endl;
+    header << "Using: Skill Index Candidates + " << engine.kernelName() << " Popcount Scoring Engine + " << scoringModel.name()
+           << " Scoring + Work-Stealing Threads" << endl;
+    header << "Processing " << queryCount << " " << labels.queryNoun << " on " << pool.getThreadCount() << " thread(s)..." << endl;
+    header << "==========================================\n";
+    sink.summary(header.str());
+    sink.flush();
     
     // Start timing
     auto startTime = chrono::high_resolution_clock::now();
     
-    int processedJobs = 0;
+    // Step 1: Score every query on the pool
+    long long pairsScored = 0;
+    vector<BestMatch> results = computeBestTargets(queries, queryCount, targets, engine, pool, pairsScored);
+    const SkillMatrix& queryMatrix = queries.getSkillMatrix();
+    int targetRows = targets.getSize();
+    vector<WorkerStats> scoringStats;
+    for (int t = 0; t < pool.getThreadCount(); t++) scoringStats.push_back(pool.getStats(t));
     
-    for (int i = 0; i < min(maxJobsToShow, size); i++) {
-        Job currentJob = dataArray[i];
-        
-        // Step 1: Use inverted index to find candidate resumes (O(1) lookup)
-        set<int> candidateResumeIds = findCandidateResumes(currentJob.skills);
-        
-        if (candidateResumeIds.empty()) {
-            cout << "\nJob ID: " << currentJob.id << endl;
-            cout << "Job Title: " << currentJob.title << endl;
-            cout << "Job Skills: " << currentJob.skills << endl;
-            cout << "No matching resumes found." << endl;
-            cout << "----------------------------------------" << endl;
-            continue;
-        }
-        
-        // Step 2: Calculate compatibility scores only for candidates (not all resumes!)
-        struct JobResumeMatch {
-            int resumeId;
-            int score;
-        };
-        
-        JobResumeMatch* matches = new JobResumeMatch[candidateResumeIds.size()];
-        int matchCount = 0;
-        
-        for (int resumeId : candidateResumeIds) {
-            // resumeId is the document ID from the index, which corresponds to the array index
-            Resume candidateResume = resumeStorage.getItem(resumeId);
-            int score = calculateCompatibility(currentJob, candidateResume);
-            
-            if (score > 0) {
-                matches[matchCount].resumeId = resumeId;
-                matches[matchCount].score = score;
-                matchCount++;
-            }
-        }
-        
-        if (matchCount == 0) {
-            cout << "\nJob ID: " << currentJob.id << endl;
-            cout << "Job Title: " << currentJob.title << endl;
-            cout << "Job Skills: " << currentJob.skills << endl;
-            cout << "No matching resumes found." << endl;
-            cout << "----------------------------------------" << endl;
-            delete[] matches;
-            continue;
-        }
-        
-        // Step 3: Use Quick Sort to sort matches by score (O(n log n))
-        if (matchCount > 1) {
-            // Custom quick sort for JobResumeMatch
-    for (int i = 0; i < matchCount - 1; i++) {
-        for (int j = 0; j < matchCount - i - 1; j++) {
-            if (matches[j].score < matches[j + 1].score) {
-                        JobResumeMatch temp = matches[j];
-                matches[j] = matches[j + 1];
-                matches[j + 1] = temp;
+    auto scoredTime = chrono::high_resolution_clock::now();
+    
+    // Step 2: Format the result blocks in parallel, one buffer per chunk
+    struct FormattedChunk {
+        string text;
+        vector<size_t> queryEnds;   // end of each query's block in text
+    };
+    int numChunks = (queryCount + MATCH_QUERIES_PER_CHUNK - 1) / MATCH_QUERIES_PER_CHUNK;
+    vector<FormattedChunk> chunks(sink.isQuiet() ? 0 : numChunks);
+    string targetCount = " (of " + to_string(targets.getLiveCount()) + " " + labels.targetNoun + ")\n";
+    if (!sink.isQuiet()) {
+        pool.parallelFor(0, queryCount, MATCH_QUERIES_PER_CHUNK, [&](int firstQuery, int lastQuery, int) {
+            FormattedChunk& chunk = chunks[firstQuery / MATCH_QUERIES_PER_CHUNK];
+            for (int i = firstQuery; i < lastQuery; i++) {
+                const BestMatch& result = results[i];
+                if (queries.isLive(i)) { // removed records print nothing
+                    formatQuery(i, chunk.text);
+                    if (result.matchCount == 0) {
+                        chunk.text += string("No matching ") + labels.targetNoun + " found.\n";
+                    } else {
+                        chunk.text += labels.targetIdLabel;
+                        for (size_t j = 0; j < result.tiedRows.size(); j++) {
+                            chunk.text += j > 0 ? ", " : ": ";
+                            chunk.text += to_string(targets.getId(result.tiedRows[j]));
+                        }
+                        chunk.text += "\nBest Score: ";
+                        chunk.text += to_string(scoringModel.displayPoints(result.bestScore, scoringModel.inverseNorm(queryMatrix.row(i))));
+                        chunk.text += "\nCandidates Found: " + to_string(result.matchCount) + targetCount;
                     }
+                    chunk.text += "----------------------------------------\n";
                 }
+                chunk.queryEnds.push_back(chunk.text.size());
             }
+        });
+    }
+    
+    // Step 3: Write the blocks in query order, with a progress line every 100 matched queries
+    int processedQueries = 0;
+    for (int i = 0; i < queryCount; i++) {
+        if (sink.isQuiet()) {
+            if (queries.isLive(i) && results[i].matchCount > 0) processedQueries++;
+            continue;
         }
+        const FormattedChunk& chunk = chunks[i / MATCH_QUERIES_PER_CHUNK];
+        int offset = i % MATCH_QUERIES_PER_CHUNK;
+        size_t begin = offset == 0 ? 0 : chunk.queryEnds[offset - 1];
+        sink.result(string_view(chunk.text).substr(begin, chunk.queryEnds[offset] - begin));
+        if (!queries.isLive(i) || results[i].matchCount == 0) continue;
         
-        // Step 4: Find best score and collect all resumes that tie
-        int bestScore = matches[0].score;
-        string resumeIds = "";
-        bool firstId = true;
-        
-        for (int j = 0; j < matchCount; j++) {
-            if (matches[j].score == bestScore) {
-                if (!firstId) resumeIds += ", ";
-                resumeIds += to_string(matches[j].resumeId);
-                firstId = false;
-            } else {
-                break; // Since sorted, no more matches with best score
-            }
-        }
-        
-        // Display results
-        cout << "\nJob ID: " << currentJob.id << endl;
-        cout << "Job Title: " << currentJob.title << endl;
-        cout << "Job Skills: " << currentJob.skills << endl;
-        cout << "Resume ID: " << resumeIds << endl;
-        cout << "Best Score: " << bestScore << endl;
-        cout << "Candidates Found: " << matchCount << " (from " << candidateResumeIds.size() << " candidates)" << endl;
-        cout << "----------------------------------------" << endl;
-        
-        delete[] matches;
-        processedJobs++;
-        
-        // Progress indicator
-        if (processedJobs % 100 == 0) {
-            cout << "[Progress: " << processedJobs << "/" << min(maxJobsToShow, size) << " jobs processed]" << endl;
+        processedQueries++;
+        if (processedQueries % 100 == 0) {
+            sink.result("[Progress: " + to_string(processedQueries) + "/" + to_string(queryCount) + " " + labels.queryNoun + " processed]\n");
         }
     }
     
     // End timing
     auto endTime = chrono::high_resolution_clock::now();
     auto duration = chrono::duration_cast<chrono::milliseconds>(endTime - startTime);
+    auto scoringDuration = chrono::duration_cast<chrono::microseconds>(scoredTime - startTime);
     double durationSeconds = duration.count() / 1000.0;
-    double avgTimePerJobMs = (processedJobs > 0 ? duration.count() / processedJobs : 0);
-    double avgTimePerJobSeconds = (processedJobs > 0 ? durationSeconds / processedJobs : 0);
-    
-    cout << "\n=== Optimization Results ===" << endl;
-    cout << "Processed " << processedJobs << " jobs in " << duration.count() << " ms (" << fixed << setprecision(3) << durationSeconds << " seconds)" << endl;
-    cout << "Average time per job: " << fixed << setprecision(1) << avgTimePerJobMs << " ms (" << fixed << setprecision(3) << avgTimePerJobSeconds << " seconds)" << endl;
-    cout << "Performance: " << fixed << setprecision(2) << (processedJobs / durationSeconds) << " jobs/second" << endl;
+    double avgTimeMs = (processedQueries > 0 ? (double)duration.count() / processedQueries : 0);
+    double avgTimeSeconds = (processedQueries > 0 ? durationSeconds / processedQueries : 0);
+    
+    ostringstream report;
+    report << "\n=== Optimization Results ===" << endl;
+    report << "Processed " << processedQueries << " " << labels.queryNoun << " in " << duration.count() << " ms (" << fixed << setprecision(3) << durationSeconds << " seconds)" << endl;
+    report << "Average time per " << labels.queryNounSingular << ": " << fixed << setprecision(1) << avgTimeMs << " ms (" << fixed << setprecision(3) << avgTimeSeconds << " seconds)" << endl;
+    report << "Performance: " << fixed << setprecision(2) << (durationSeconds > 0 ? processedQueries / durationSeconds : 0) << " " << labels.queryNoun << "/second" << endl;
+    report << "Scoring engine (" << engine.kernelName() << "): " << pairsScored << " candidate pairs scored (of "
+           << fixed << setprecision(0) << (double)queryCount * targetRows << ") in "
+           << fixed << setprecision(3) << scoringDuration.count() / 1000.0 << " ms" << endl;
+    
+    // Per-thread scoring throughput
+    report << "Threads: " << pool.getThreadCount() << " (chunks of " << MATCH_QUERIES_PER_CHUNK << " " << labels.queryNoun << ")" << endl;
+    for (int t = 0; t < pool.getThreadCount(); t++) {
+        const WorkerStats& stats = scoringStats[t];
+        report << "  Thread " << t << ": " << stats.items << " " << labels.queryNoun << " in " << stats.tasksRun << " chunks ("
+               << stats.tasksStolen << " stolen), busy " << fixed << setprecision(1) << stats.busySeconds * 1000.0 << " ms, "
+               << fixed << setprecision(2) << (stats.busySeconds > 0 ? stats.items / stats.busySeconds : 0) << " " << labels.queryNoun << "/second" << endl;
+    }
+    sink.summary(report.str());
+    sink.flush();
 }
 
-// External compatibility function (needs to be accessible)
-int calculateCompatibility(const Job& job, const Resume& resume) {
-    int score = 0;
-    
-    // Normalize skills for comparison
-    string jobSkills = job.getSkills();
-    string resumeSkills = resume.getSkills();
-    
-    // Convert to lowercase for comparison
-    transform(jobSkills.begin(), jobSkills.end(), jobSkills.begin(), ::tolower);
-    transform(resumeSkills.begin(), resumeSkills.end(), resumeSkills.begin(), ::tolower);
-    
-    // Count matching skills
-    istringstream jobStream(jobSkills);
-    string skill;
-    while (jobStream >> skill) {
-        if (resumeSkills.find(skill) != string::npos) {
-            score += 5; // Each matching skill adds 5 points
+// Best-matching resumes for each job (candidates from the resume skill index)
+// This function is only available for Job arrays
+template<>
+void Array<Job>::findBestMatchesForJobs(const Array<Resume>& resumeStorage, int maxJobsToShow, ResultSink& sink, int numThreads) const {
+    MatchLabels labels = {"Job-Resume", "jobs", "job", "resumes", "Resume ID"};
+    matchBestTargets(*this, min(maxJobsToShow, getSize()), resumeStorage, numThreads, labels, sink, [this](int i, string& out) {
+        out += "\nJob ID: " + to_string(getId(i)) + "\n";
+        out += "Job Title: ";
+        out += getTitle(i);
+        out += "\nJob Skills: ";
+        out += getSkills(i);
+        out += "\n";
+    });
+}
+
+// Best-matching jobs for each resume (candidates from the job skill index)
+// This function is only available for Resume arrays
+template<>
+void Array<Resume>::findBestMatchesForResumes(const Array<Job>& jobStorage, int maxResumesToShow, ResultSink& sink, int numThreads) const {
+    MatchLabels labels = {"Resume-Job", "resumes", "resume", "jobs", "Job ID"};
+    matchBestTargets(*this, min(maxResumesToShow, getSize()), jobStorage, numThreads, labels, sink, [this](int i, string& out) {
+        out += "\nResume ID: " + to_string(getId(i)) + "\n";
+        out += "Resume Skills: ";
+        out += getSkills(i);
+        out += "\n";
+    });
+}
+
+// Candidates kept per job and per resume for the global assignment
+const int ASSIGNMENT_CANDIDATES = 128;
+
+// Largest number of jobs one resume may take in a global assignment. The auction copies each
+// edge once per slot of its resume, so its memory and time grow with the capacity.
+const int MAX_RESUME_CAPACITY = 16;
+
+// The best (up to) limit targets of every query row, as (query, target) pairs. Selection is by
+// scoringModel.pairWeight; equal weights are ordered by a hash of the pair, so rows with many
+// equally good targets keep different ones instead of all keeping the lowest IDs.
+template<typename U>
+vector<pair<int, int>> topCandidatePairs(const SkillMatrix& queryMatrix, const CandidateScorer<U>& scorer,
+                                         int limit, WorkStealingPool& pool) {
+    const int TIE_BITS = 10;
+    vector<vector<pair<int, int>>> workerPairs(pool.getThreadCount());
+    pool.parallelFor(0, queryMatrix.getRows(), 64, [&](int firstQuery, int lastQuery, int workerId) {
+        TopKCollector top(limit);
+        CandidateScratch scratch;
+        for (int q = firstQuery; q < lastQuery; q++) {
+            uint32_t queryInverseNorm = scoringModel.inverseNorm(queryMatrix.row(q));
+            top.clear();
+            scorer.scoreQuery(queryMatrix.row(q), scratch, [&](int row, int64_t score) {
+                uint32_t tie = ((uint32_t)q * 2654435761u ^ (uint32_t)row * 2246822519u) * 3266489917u;
+                top.offer(row, (int)(scoringModel.pairWeight(score, queryInverseNorm) << TIE_BITS | tie >> (32 - TIE_BITS)));
+            });
+            for (const Match& match : top.sortedResults()) workerPairs[workerId].push_back(make_pair(q, match.index));
         }
+    });
+    vector<pair<int, int>> pairs;
+    for (const vector<pair<int, int>>& buffer : workerPairs) pairs.insert(pairs.end(), buffer.begin(), buffer.end());
+    return pairs;
+}
+
+// Global assignment: every job gets at most one resume and every resume at most resumeCapacity
+// jobs, maximizing the summed pair weight (scoringModel.pairWeight). The graph holds only the
+// ASSIGNMENT_CANDIDATES best resumes of each job plus the best jobs of each resume (from the
+// skill indexes, never a job x resume matrix), and the auction solver is exact on that graph.
+// Shows the first maxJobsToShow jobs with their resumes, then totals and timing.
+template<>
+void Array<Job>::assignResumes(const Array<Resume>& resumeStorage, int maxJobsToShow, ResultSink& sink,
+                               int resumeCapacity, int numThreads) const {
+    ScoringEngine engine;
+    WorkStealingPool pool(numThreads);
+    resumeCapacity = min(max(resumeCapacity, 1), MAX_RESUME_CAPACITY);
+    
+    ostringstream header;
+    header << "\n=== Global Job-Resume Assignment ===" << endl;
+    header << "Using: Skill Index Candidates + " << engine.kernelName() << " Popcount Scoring Engine + " << scoringModel.name()
+           << " Scoring + Auction Algorithm" << endl;
+    header << "Assigning " << getLiveCount() << " jobs to " << resumeStorage.getLiveCount() << " resumes (up to "
+           << resumeCapacity << " job(s) per resume) on " << pool.getThreadCount() << " thread(s)..." << endl;
+    header << "==========================================\n";
+    sink.summary(header.str());
+    sink.flush();
+    
+    auto startTime = chrono::high_resolution_clock::now();
+    
+    // Step 1: Candidate edges in both directions, merged per job
+    const SkillMatrix& jobMatrix = getSkillMatrix();
+    const SkillMatrix& resumeMatrix = resumeStorage.getSkillMatrix();
+    vector<pair<int, int>> edges;
+    {
+        CandidateScorer<Resume> resumeScorer(resumeStorage, engine);
+        edges = topCandidatePairs(jobMatrix, resumeScorer, ASSIGNMENT_CANDIDATES, pool);
+    }
+    {
+        CandidateScorer<Job> jobScorer(*this, engine);
+        for (const pair<int, int>& edge : topCandidatePairs(resumeMatrix, jobScorer, ASSIGNMENT_CANDIDATES, pool)) {
+            edges.push_back(make_pair(edge.second, edge.first));
+        }
+    }
+    sort(edges.begin(), edges.end());
+    edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    
+    // Weights in job orientation, so both directions agree on every edge
+    vector<uint32_t> jobInverseNorms = scoringModel.inverseNorms(jobMatrix);
+    vector<uint32_t> resumeInverseNorms = scoringModel.inverseNorms(resumeMatrix);
+    AssignmentGraph graph;
+    graph.leftCount = jobMatrix.getRows();
+    graph.rightCount = resumeMatrix.getRows();
+    graph.edgeStart.assign(graph.leftCount + 1, 0);
+    for (const pair<int, int>& edge : edges) {
+        int64_t score = scoringModel.pairScore(jobMatrix.row(edge.first), resumeMatrix.row(edge.second), resumeInverseNorms[edge.second]);
+        int64_t weight = scoringModel.pairWeight(score, jobInverseNorms[edge.first]);
+        if (weight <= 0) continue;
+        graph.edgeRight.push_back(edge.second);
+        graph.edgeWeight.push_back(weight);
+        graph.edgeStart[edge.first + 1]++;
+    }
+    for (int j = 0; j < graph.leftCount; j++) graph.edgeStart[j + 1] += graph.edgeStart[j];
+    
+    auto graphTime = chrono::high_resolution_clock::now();
+    
+    // Step 2: Solve
+    AssignmentResult assignment = solveAssignment(graph, resumeCapacity);
+    
+    auto solvedTime = chrono::high_resolution_clock::now();
+    
+    // Step 3: Display the first jobs in ID order
+    int jobsToShow = sink.isQuiet() ? 0 : min(maxJobsToShow, getSize());
+    string text;
+    for (int j = 0; j < jobsToShow; j++) {
+        if (!isLive(j)) continue; // removed record
+        text += "\nJob ID: " + to_string(getId(j)) + "\n";
+        text += "Job Title: ";
+        text += getTitle(j);
+        text += "\nJob Skills: ";
+        text += getSkills(j);
+        text += "\n";
+        int r = assignment.rightOf[j];
+        if (r < 0) {
+            text += "No resume assigned.\n";
+        } else {
+            text += "Assigned Resume ID: " + to_string(resumeStorage.getId(r)) + "\n";
+            text += "Resume Skills: ";
+            text += resumeStorage.getSkills(r);
+            text += "\nScore: " + to_string(scoringModel.compatibility(getSkillSet(j), resumeStorage.getSkillSet(r))) + "\n";
+        }
+        text += "----------------------------------------\n";
+    }
+    sink.result(text);
+    
+    vector<int> jobsPerResume(graph.rightCount, 0);
+    long long totalPoints = 0;
+    int distinctResumes = 0;
+    for (int j = 0; j < graph.leftCount; j++) {
+        int r = assignment.rightOf[j];
+        if (r < 0) continue;
+        if (jobsPerResume[r]++ == 0) distinctResumes++;
+        totalPoints += scoringModel.compatibility(getSkillSet(j), resumeStorage.getSkillSet(r));
     }
     
-    return score;
+    auto endTime = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::milliseconds>(endTime - startTime);
+    auto graphDuration = chrono::duration_cast<chrono::microseconds>(graphTime - startTime);
+    auto solveDuration = chrono::duration_cast<chrono::microseconds>(solvedTime - graphTime);
+    
+    ostringstream report;
+    report << "\n=== Assignment Results ===" << endl;
+    report << "Assigned " << assignment.assignedCount << " of " << getLiveCount() << " jobs to " << distinctResumes << " distinct resumes" << endl;
+    report << "Total score: " << totalPoints << " points (average "
+           << fixed << setprecision(1) << (assignment.assignedCount > 0 ? (double)totalPoints / assignment.assignedCount : 0) << " per assigned job)" << endl;
+    report << "Candidate graph: " << graph.edgeRight.size() << " edges (best " << ASSIGNMENT_CANDIDATES
+           << " per job and per resume) built in " << fixed << setprecision(3) << graphDuration.count() / 1000.0 << " ms" << endl;
+    report << "Auction: " << assignment.scalingPhases << " epsilon-scaling phases, " << assignment.bids << " bids in "
+           << fixed << setprecision(3) << solveDuration.count() / 1000.0 << " ms" << endl;
+    report << "Total time: " << duration.count() << " ms (" << fixed << setprecision(3) << duration.count() / 1000.0 << " seconds)" << endl;
+    sink.summary(report.str());
+    sink.flush();
 }
 
-// Search jobs by title (only for Job objects)
+// External compatibility function (needs to be accessible)
+int calculateCompatibility(const Job& job, const Resume& resume) {
+    // Points under the configured scoring model (integer skill IDs, precomputed IDF weights)
+    return scoringModel.compatibility(job.skillBits, resume.skillBits);
+}
+
+// Search jobs by title (only for Job objects): the best maxResults matches, best first.
+// candidateCount (optional) receives the number of jobs the title index returned.
 template<>
-void Array<Job>::displayMatchesByTitle(const string& titleKeyword, int maxResults) const {
+vector<Match> Array<Job>::searchByTitle(const string& titleKeyword, int maxResults, int* candidateCount) const {
     // Build index if not already built
     if (!indexBuilt) {
         cout << "Building inverted index for fast search..." << endl;
@@ -1206,25 +1426,21 @@ void Array<Job>::displayMatchesByTitle(const string& titleKeyword, int maxResult
     }
     
     // Use title index for fast search
-    set<int> candidateIds = searchIndex(titleKeyword, titleIndex);
+    DocIdList candidateIds = searchIndex(titleKeyword, FIELD_TITLE);
+    if (candidateCount != nullptr) *candidateCount = (int)candidateIds.size();
     
     if (candidateIds.empty()) {
-        cout << "No jobs found with title containing '" << titleKeyword << "'" << endl;
-        return;
+        return vector<Match>();
     }
     
-    // Create array to store scores and indices for candidates only
-    Match* matches = new Match[candidateIds.size()];
-    int matchCount = 0;
-    
     string normTitle = normalizeText(titleKeyword);
     
-    // Only process candidates from inverted index (much faster!)
-    for (int docId : candidateIds) {
+    // Score only the candidates from the inverted index, keeping the best maxResults
+    auto scoreCandidate = [&](int docId) {
         int score = 0;
         
-        string normJobTitle = normalizeText(dataArray[docId].title);
-        string normDesc = normalizeText(dataArray[docId].getText());
+        string normJobTitle = normalizeText(string(records.title(docId)));
+        string normDesc = normalizeText(getText(docId));
         
         // Score based on title match
         if (normJobTitle.find(normTitle) != string::npos) {
@@ -1245,31 +1461,35 @@ void Array<Job>::displayMatchesByTitle(const string& titleKeyword, int maxResult
                 score += 2; // Small bonus for word match in description
             }
         }
-        
-        if (score > 0) {
-            matches[matchCount].index = docId;
-            matches[matchCount].score = score;
-            matchCount++;
-        }
-    }
+        return score;
+    };
+    TopKCollector topK(maxResults);
+    collectTopMatches(candidateIds, scoreCandidate, topK);
+    return topK.sortedResults();
+}
+
+// Search jobs by title, reported to sink
+template<>
+void Array<Job>::displayMatchesByTitle(const string& titleKeyword, int maxResults, ResultSink& sink) const {
+    int candidateCount = 0;
+    vector<Match> topResults = searchByTitle(titleKeyword, maxResults, &candidateCount);
     
-    // Top-K optimization: Only get the top results we need to display
-    int resultsToShow = min(maxResults, matchCount);
-    Match* topResults = new Match[resultsToShow];
-    getTopKMatches(matches, matchCount, resultsToShow, topResults);
+    if (candidateCount == 0) {
+        sink.summary("No jobs found with title containing '" + titleKeyword + "'\n");
+        sink.flush();
+        return;
+    }
+    int resultsToShow = (int)topResults.size();
     
     // Display results
-    cout << "\n=== Top " << resultsToShow << " Job Title Matches for '" << titleKeyword << "' ===" << endl;
-    cout << endl;
-    
+    sink.summary("\n=== Top " + to_string(resultsToShow) + " Job Title Matches for '" + titleKeyword + "' ===\n\n");
+    string text;
     for (int i = 0; i < resultsToShow; i++) {
-        cout << "Match " << (i + 1) << " (Score: " << topResults[i].score << "):" << endl;
-        dataArray[topResults[i].index].display();
+        text += "Match " + to_string(i + 1) + " (Score: " + to_string(topResults[i].score) + "):\n";
+        display(topResults[i].index, text);
     }
-    
-    // Clean up
-    delete[] matches;
-    delete[] topResults;
+    sink.result(text);
+    sink.flush();
 }
 
 
@@ -1277,3 +1497,55 @@ void Array<Job>::displayMatchesByTitle(const string& titleKeyword, int maxResult
 template class Array<Job>;
 template class Array<Resume>;
 
+// Dataset snapshot: skill dictionary + jobs + resumes (with their indexes) in one checksummed file
+
+// True if the snapshot exists and is at least as new as every source file
+bool isSnapshotFresh(const string& snapshotPath, const vector<string>& sourcePaths) {
+    error_code error;
+    filesystem::file_time_type snapshotTime = filesystem::last_write_time(snapshotPath, error);
+    if (error) return false;
+    for (const string& source : sourcePaths) {
+        filesystem::file_time_type sourceTime = filesystem::last_write_time(source, error);
+        if (error || sourceTime > snapshotTime) return false;
+    }
+    return true;
+}
+
+bool saveSnapshot(const string& snapshotPath, Array<Job>& jobs, Array<Resume>& resumes) {
+    SnapshotWriter out;
+    // Skill IDs inside the records only mean something with the same dictionary (and the
+    // same aliases and hierarchy, which decided the encoded skill bits)
+    out.put<int32_t>(skillDictionary.size());
+    for (int i = 0; i < skillDictionary.size(); i++) {
+        out.putString(skillDictionary.getName(i));
+    }
+    out.put<uint64_t>(skillDictionary.fingerprint());
+    jobs.writeSnapshot(out);
+    resumes.writeSnapshot(out);
+    return out.writeFile(snapshotPath);
+}
+
+// Returns false (leaving both arrays empty) if the snapshot is missing, corrupt,
+// from another format version or built with a different skill dictionary or taxonomy
+bool loadSnapshot(const string& snapshotPath, Array<Job>& jobs, Array<Resume>& resumes) {
+    MappedFile file;
+    if (!file.open(snapshotPath)) return false;
+    SnapshotReader in;
+    if (!in.open(file.data(), file.size())) return false;
+
+    int skillCount = in.get<int32_t>();
+    if (!in.ok() || skillCount != skillDictionary.size()) return false;
+    for (int i = 0; i < skillCount; i++) {
+        if (in.getString() != skillDictionary.getName(i)) return false;
+    }
+    if (in.get<uint64_t>() != skillDictionary.fingerprint() || !in.ok()) return false;
+
+    if (!jobs.readSnapshot(in) || !resumes.readSnapshot(in) || !in.atEnd()) {
+        jobs.clear();
+        resumes.clear();
+        return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef ASSIGNMENT_CPP
+#define ASSIGNMENT_CPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+using namespace std;
+
+// Sparse weighted bipartite graph in compressed rows: left vertex l has the edges
+// [edgeStart[l], edgeStart[l + 1]) of edgeRight / edgeWeight
+struct AssignmentGraph {
+    int leftCount;
+    int rightCount;
+    vector<int> edgeStart;      // leftCount + 1 offsets
+    vector<int> edgeRight;      // distinct right vertices per left vertex
+    vector<int64_t> edgeWeight; // > 0
+};
+
+struct AssignmentResult {
+    vector<int> rightOf;        // assigned right vertex of each left vertex, -1 = unassigned
+    int64_t totalWeight;
+    int assignedCount;
+    int scalingPhases;
+    long long bids;
+};
+
+// Shrink epsilon this much between auction phases
+const int AUCTION_SCALING_FACTOR = 6;
+
+// Maximum-weight assignment of left vertices to right vertices, each right vertex taking at most
+// rightCapacity left vertices; vertices may stay unassigned. Solved exactly with the auction
+// algorithm (forward Gauss-Seidel bidding, epsilon scaling) on a symmetric problem in which every
+// vertex can always be matched:
+//   persons = left vertices + one "slot keeper" per right slot
+//   objects = right slots + one "idle" object per left vertex; right vertex r has
+//             min(rightCapacity, left vertices adjacent to r) slots, as it can never take more
+//   left l     -> every slot of its right vertices (weight), or its own idle object (0)
+//   keeper of s -> slot s (0: s stays empty), or the idle object of any left vertex adjacent to s's
+//                 right vertex (0: frees that slot for the left vertex)
+// Perfect matchings of this problem and assignments of the original one have the same weights.
+// Benefits are scaled by (persons + 1), so bidding down to epsilon = 1 leaves the result optimal.
+// Only the edges are stored: memory and time follow the edge count, never left x right.
+AssignmentResult solveAssignment(const AssignmentGraph& graph, int rightCapacity) {
+    AssignmentResult result;
+    result.rightOf.assign(graph.leftCount, -1);
+    result.totalWeight = 0;
+    result.assignedCount = 0;
+    result.scalingPhases = 0;
+    result.bids = 0;
+    if (rightCapacity < 1) return result;
+
+    // Only vertices with edges take part
+    vector<int> activeLeft;
+    vector<vector<int>> leftsOfRight(graph.rightCount);
+    int64_t maxWeight = 0;
+    for (int l = 0; l < graph.leftCount; l++) {
+        if (graph.edgeStart[l] == graph.edgeStart[l + 1]) continue;
+        for (int e = graph.edgeStart[l]; e < graph.edgeStart[l + 1]; e++) {
+            leftsOfRight[graph.edgeRight[e]].push_back((int)activeLeft.size());
+            maxWeight = max(maxWeight, graph.edgeWeight[e]);
+        }
+        activeLeft.push_back(l);
+    }
+    if (activeLeft.empty()) return result;
+
+    vector<int> firstSlot(graph.rightCount, -1);
+    vector<int> slotCount(graph.rightCount, 0);
+    vector<int> slotRight;
+    for (int r = 0; r < graph.rightCount; r++) {
+        if (leftsOfRight[r].empty()) continue;
+        firstSlot[r] = (int)slotRight.size();
+        slotCount[r] = min(rightCapacity, (int)leftsOfRight[r].size());
+        for (int k = 0; k < slotCount[r]; k++) slotRight.push_back(r);
+    }
+
+    int leftPersons = (int)activeLeft.size();
+    int slots = (int)slotRight.size();
+    int persons = leftPersons + slots; // == objects
+    int64_t scale = persons + 1;
+
+    // Person rows: (object, benefit)
+    vector<int> rowStart(persons + 1, 0);
+    vector<int> rowObject;
+    vector<int64_t> rowBenefit;
+    for (int p = 0; p < leftPersons; p++) {
+        int l = activeLeft[p];
+        for (int e = graph.edgeStart[l]; e < graph.edgeStart[l + 1]; e++) {
+            for (int k = 0; k < slotCount[graph.edgeRight[e]]; k++) {
+                rowObject.push_back(firstSlot[graph.edgeRight[e]] + k);
+                rowBenefit.push_back(graph.edgeWeight[e] * scale);
+            }
+        }
+        rowObject.push_back(slots + p);
+        rowBenefit.push_back(0);
+        rowStart[p + 1] = (int)rowObject.size();
+    }
+    for (int s = 0; s < slots; s++) {
+        rowObject.push_back(s);
+        rowBenefit.push_back(0);
+        for (int p : leftsOfRight[slotRight[s]]) {
+            rowObject.push_back(slots + p);
+            rowBenefit.push_back(0);
+        }
+        rowStart[leftPersons + s + 1] = (int)rowObject.size();
+    }
+
+    int64_t maxBenefit = maxWeight * scale;
+    vector<int64_t> price(persons, 0);
+    vector<int> owner(persons);         // person holding each object, -1 = free
+    vector<int> assigned(persons);      // object held by each person, -1 = bidding
+    vector<int> waiting(persons);       // ring buffer of unassigned persons (each at most once)
+
+    int64_t epsilon = max<int64_t>(1, maxBenefit / AUCTION_SCALING_FACTOR);
+    while (true) {
+        result.scalingPhases++;
+        fill(owner.begin(), owner.end(), -1);
+        fill(assigned.begin(), assigned.end(), -1);
+        for (int p = 0; p < persons; p++) waiting[p] = p;
+        int head = 0;
+        int pending = persons;
+
+        while (pending > 0) {
+            int p = waiting[head];
+            head = head + 1 == persons ? 0 : head + 1;
+            pending--;
+
+            // Best and second-best net value among the person's objects
+            int bestObject = -1;
+            int64_t bestValue = INT64_MIN, secondValue = INT64_MIN;
+            for (int e = rowStart[p]; e < rowStart[p + 1]; e++) {
+                int64_t value = rowBenefit[e] - price[rowObject[e]];
+                if (value > bestValue) {
+                    secondValue = bestValue;
+                    bestValue = value;
+                    bestObject = rowObject[e];
+                } else if (value > secondValue) {
+                    secondValue = value;
+                }
+            }
+            if (secondValue == INT64_MIN) secondValue = bestValue - maxBenefit; // single choice
+
+            // Bid: raise the price until the object is only epsilon better than the runner-up
+            price[bestObject] += bestValue - secondValue + epsilon;
+            result.bids++;
+            int outbid = owner[bestObject];
+            owner[bestObject] = p;
+            assigned[p] = bestObject;
+            if (outbid >= 0) {
+                assigned[outbid] = -1;
+                waiting[(head + pending) % persons] = outbid;
+                pending++;
+            }
+        }
+
+        if (epsilon == 1) break;
+        epsilon = max<int64_t>(1, epsilon / AUCTION_SCALING_FACTOR);
+    }
+
+    for (int p = 0; p < leftPersons; p++) {
+        int object = assigned[p];
+        if (object >= slots) continue; // idle
+        int l = activeLeft[p];
+        int r = slotRight[object];
+        for (int e = graph.edgeStart[l]; e < graph.edgeStart[l + 1]; e++) {
+            if (graph.edgeRight[e] != r) continue;
+            result.rightOf[l] = r;
+            result.totalWeight += graph.edgeWeight[e];
+            result.assignedCount++;
+            break;
+        }
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef BATCH_CPP
+#define BATCH_CPP
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <iomanip>
+#include <cstdlib>
+#include "array.cpp"
+#include "result_writer.cpp"
+using namespace std;
+
+// Non-interactive batch mode: runs title / skill searches and the all-jobs match from
+// command-line flags or a query file, and writes the results as CSV, JSON Lines or binary.
+
+struct BatchQuery {
+    QueryKind kind;
+    string text;    // search text (unused for match queries)
+};
+
+struct BatchOptions {
+    vector<BatchQuery> queries;     // in the order given
+    int topResults;                 // results per query, 0 = all
+    string format;                  // csv | jsonl | binary
+    string outputPath;              // "-" = stdout
+    int numThreads;                 // matcher threads, 0 = all cores
+    bool showHelp;
+
+    BatchOptions() : topResults(10), format("csv"), outputPath("-"), numThreads(0), showHelp(false) {}
+};
+
+void printBatchUsage(ostream& out) {
+    out << "Usage: program [options]          (no options = interactive menu)\n"
+        << "  --title TEXT           search jobs by title\n"
+        << "  --skills TEXT          search jobs by skills (same syntax as the menu)\n"
+        << "  --resume-skills TEXT   search resumes by skills\n"
+        << "  --match-all            best resumes for every job\n"
+        << "  --queries FILE         more queries, one per line: 'title: TEXT', 'skills: TEXT',\n"
+        << "                         'resume-skills: TEXT' or 'match' ('#' starts a comment)\n"
+        << "  --top N                results per query (default 10, 0 = all)\n"
+        << "  --format FORMAT        csv (default), jsonl or binary\n"
+        << "  --output FILE          write results to FILE (default: stdout)\n"
+        << "  --threads N            matcher threads (default 0 = all cores)\n"
+        << "  --help                 show this help\n"
+        << "Status messages go to stderr.\n";
+}
+
+// Query file lines: "<type>: <text>" or "match"; blank lines and '#' comments are skipped
+bool readQueryFile(const string& path, vector<BatchQuery>& queries, string& error) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        error = "cannot open query file " + path;
+        return false;
+    }
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != string::npos) line.erase(comment);
+        line.erase(0, line.find_first_not_of(" \t"));
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty()) continue;
+        if (line == "match") {
+            queries.push_back(BatchQuery{QUERY_JOB_MATCH, ""});
+            continue;
+        }
+
+        size_t colon = line.find(':');
+        string type = colon == string::npos ? "" : line.substr(0, colon);
+        string text = colon == string::npos ? "" : line.substr(colon + 1);
+        text.erase(0, text.find_first_not_of(" \t"));
+        BatchQuery query;
+        if (type == "title") query.kind = QUERY_JOB_TITLE;
+        else if (type == "skills") query.kind = QUERY_JOB_SKILLS;
+        else if (type == "resume-skills") query.kind = QUERY_RESUME_SKILLS;
+        else {
+            error = path + ":" + to_string(lineNumber) + ": expected 'title:', 'skills:', 'resume-skills:' or 'match'";
+            return false;
+        }
+        if (text.empty()) {
+            error = path + ":" + to_string(lineNumber) + ": empty query";
+            return false;
+        }
+        query.text = text;
+        queries.push_back(query);
+    }
+    return true;
+}
+
+bool parseBatchOptions(int argc, char* argv[], BatchOptions& options, string& error) {
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag == "--help" || flag == "-h") {
+            options.showHelp = true;
+            continue;
+        }
+        if (flag == "--match-all") {
+            options.queries.push_back(BatchQuery{QUERY_JOB_MATCH, ""});
+            continue;
+        }
+        static const char* const VALUE_FLAGS[] = {"--title", "--skills", "--resume-skills", "--queries",
+                                                   "--top", "--threads", "--format", "--output"};
+        if (find(begin(VALUE_FLAGS), end(VALUE_FLAGS), flag) == end(VALUE_FLAGS)) {
+            error = "unknown option " + flag;
+            return false;
+        }
+        if (i + 1 >= argc) {
+            error = "missing value for " + flag;
+            return false;
+        }
+        string value = argv[++i];
+        if (flag == "--title") options.queries.push_back(BatchQuery{QUERY_JOB_TITLE, value});
+        else if (flag == "--skills") options.queries.push_back(BatchQuery{QUERY_JOB_SKILLS, value});
+        else if (flag == "--resume-skills") options.queries.push_back(BatchQuery{QUERY_RESUME_SKILLS, value});
+        else if (flag == "--queries") {
+            if (!readQueryFile(value, options.queries, error)) return false;
+        } else if (flag == "--top" || flag == "--threads") {
+            char* end = nullptr;
+            long number = strtol(value.c_str(), &end, 10);
+            if (value.empty() || *end != '\0' || number < 0 || number > 1000000000) {
+                error = "invalid number for " + flag + ": " + value;
+                return false;
+            }
+            if (flag == "--top") options.topResults = (int)number;
+            else options.numThreads = (int)number;
+        } else if (flag == "--format") {
+            if (value != "csv" && value != "jsonl" && value != "binary") {
+                error = "unknown format " + value + " (expected csv, jsonl or binary)";
+                return false;
+            }
+            options.format = value;
+        } else {
+            options.outputPath = value;
+        }
+    }
+    if (!options.showHelp && options.queries.empty()) {
+        error = "no queries given";
+        return false;
+    }
+    return true;
+}
+
+// Run every query in order and write the results; returns the process exit code
+int runBatch(const BatchOptions& options, const Array<Job>& jobStorage, const Array<Resume>& resumeStorage) {
+    BufferedWriter output;
+    if (!output.open(options.outputPath)) {
+        cerr << "Error: Cannot create " << options.outputPath << endl;
+        return 1;
+    }
+    unique_ptr<ResultWriter> writer = createResultWriter(options.format, output);
+
+    auto startTime = chrono::high_resolution_clock::now();
+    int queryCount = 0;
+    long long rowCount = 0;
+
+    for (const BatchQuery& query : options.queries) {
+        if (query.kind == QUERY_JOB_MATCH) {
+            // One result query per live job: its tied best resumes
+            ScoringEngine engine;
+            WorkStealingPool pool(options.numThreads);
+            long long pairsScored = 0;
+            vector<BestMatch> matches = computeBestTargets(jobStorage, jobStorage.getSize(), resumeStorage, engine, pool, pairsScored);
+            const SkillMatrix& jobMatrix = jobStorage.getSkillMatrix();
+            for (int j = 0; j < jobStorage.getSize(); j++) {
+                if (!jobStorage.isLive(j)) continue;
+                int queryId = queryCount++;
+                string jobId = to_string(jobStorage.getId(j));
+                writer->beginQuery(queryId, QUERY_JOB_MATCH, jobId);
+                const BestMatch& match = matches[j];
+                int score = scoringModel.displayPoints(match.bestScore, scoringModel.inverseNorm(jobMatrix.row(j)));
+                int rows = (int)match.tiedRows.size();
+                if (options.topResults > 0) rows = min(rows, options.topResults);
+                for (int rank = 0; rank < rows; rank++) {
+                    ResultRow row = {queryId, QUERY_JOB_MATCH, &jobId, rank + 1, resumeStorage.getId(match.tiedRows[rank]), score};
+                    writer->writeRow(row);
+                }
+                rowCount += rows;
+            }
+            continue;
+        }
+
+        int queryId = queryCount++;
+        writer->beginQuery(queryId, query.kind, query.text);
+        bool searchJobs = query.kind != QUERY_RESUME_SKILLS;
+        int limit = options.topResults > 0 ? options.topResults
+                                           : max(1, searchJobs ? jobStorage.getSize() : resumeStorage.getSize());
+        vector<Match> results;
+        if (query.kind == QUERY_JOB_TITLE) results = jobStorage.searchByTitle(query.text, limit);
+        else if (query.kind == QUERY_JOB_SKILLS) results = jobStorage.searchBySkills(query.text, limit);
+        else results = resumeStorage.searchBySkills(query.text, limit);
+        for (size_t rank = 0; rank < results.size(); rank++) {
+            int id = searchJobs ? jobStorage.getId(results[rank].index) : resumeStorage.getId(results[rank].index);
+            ResultRow row = {queryId, query.kind, &query.text, (int)rank + 1, id, results[rank].score};
+            writer->writeRow(row);
+        }
+        rowCount += (long long)results.size();
+    }
+
+    writer->finish();
+    bool written = output.close();
+    auto duration = chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - startTime);
+    if (!written) {
+        cerr << "Error: Failed writing " << options.outputPath << endl;
+        return 1;
+    }
+
+    // Sub-microsecond runs count as 1 us so the rate stays finite
+    double seconds = max<long long>(duration.count(), 1) / 1000000.0;
+    cerr << "Batch: " << queryCount << " queries, " << rowCount << " result rows (" << options.format << ") written to "
+         << (options.outputPath == "-" ? "stdout" : options.outputPath) << " in "
+         << fixed << setprecision(3) << duration.count() / 1000.0 << " ms ("
+         << fixed << setprecision(2) << queryCount / seconds << " queries/second)" << endl;
+    return 0;
+}
+
+#endif
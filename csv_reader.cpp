@@ -0,0 +1,316 @@
+#ifndef CSV_READER_CPP
+#define CSV_READER_CPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <fstream>
+#include "skills.cpp"
+#include "thread_pool.cpp"
+
+#ifdef _WIN32
+#define CSV_READER_NO_MMAP 1
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define CSV_READER_SSE2 1
+#endif
+
+using namespace std;
+
+// Read-only view of a whole file: memory-mapped where available, read into a buffer otherwise
+class MappedFile {
+private:
+    const char* mappedData;
+    size_t mappedSize;
+    vector<char> buffer; // fallback storage when mmap is not available
+
+public:
+    MappedFile() : mappedData(nullptr), mappedSize(0) {}
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const string& filename) {
+        close();
+#ifndef CSV_READER_NO_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        mappedSize = (size_t)info.st_size;
+        if (mappedSize > 0) {
+            void* mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                mappedSize = 0;
+                return false;
+            }
+            madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+            mappedData = (const char*)mapping;
+        }
+        ::close(fd); // the mapping stays valid after the descriptor is closed
+        return true;
+#else
+        ifstream file(filename, ios::binary | ios::ate);
+        if (!file.is_open()) return false;
+        buffer.resize((size_t)file.tellg());
+        file.seekg(0);
+        file.read(buffer.data(), buffer.size());
+        mappedData = buffer.data();
+        mappedSize = buffer.size();
+        return true;
+#endif
+    }
+
+    void close() {
+#ifndef CSV_READER_NO_MMAP
+        if (mappedData != nullptr && buffer.empty()) {
+            munmap((void*)mappedData, mappedSize);
+        }
+#endif
+        buffer.clear();
+        mappedData = nullptr;
+        mappedSize = 0;
+    }
+
+    const char* data() const { return mappedData; }
+    size_t size() const { return mappedSize; }
+};
+
+// One field of a CSV record: a view into the file (quotes not yet removed)
+struct CsvField {
+    string_view text;
+    bool hasQuotes;
+
+    // Copy the field into a string, dropping quote characters (only done when a field is really needed)
+    string materialize() const {
+        if (!hasQuotes) return string(text);
+        string value;
+        value.reserve(text.size());
+        for (char c : text) {
+            if (c != '"') value += c;
+        }
+        return value;
+    }
+
+    // Same as materialize(), into an existing string (reuses its capacity)
+    void materializeTo(string& value) const {
+        if (!hasQuotes) {
+            value.assign(text.data(), text.size());
+            return;
+        }
+        value.clear();
+        for (char c : text) {
+            if (c != '"') value += c;
+        }
+    }
+
+    // Parse a leading integer (after optional spaces/quotes); returns fallback if there is none
+    int toInt(int fallback) const {
+        const char* p = text.data();
+        const char* end = p + text.size();
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '"')) p++;
+        int value = fallback;
+        from_chars_result result = from_chars(p, end, value);
+        return result.ec == errc() ? value : fallback;
+    }
+};
+
+// A parsed CSV record: up to MAX_FIELDS field views plus the whole line
+struct CsvRecord {
+    static const int MAX_FIELDS = 16;
+    CsvField fields[MAX_FIELDS];
+    int fieldCount;
+    string_view line;
+
+    bool isBlank() const { return line.empty(); }
+};
+
+// Zero-copy CSV scanner over an in-memory buffer.
+// Quote, comma and newline characters are located 16 bytes at a time (SSE2),
+// and records are returned as views into the buffer.
+class CsvReader {
+private:
+    const char* pos;
+    const char* end;
+
+    // Next '"', ',' or '\n' at or after p (end if none)
+    static const char* findStructural(const char* p, const char* end) {
+#ifdef CSV_READER_SSE2
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i comma = _mm_set1_epi8(',');
+        const __m128i newline = _mm_set1_epi8('\n');
+        while (p + 16 <= end) {
+            __m128i chunk = _mm_loadu_si128((const __m128i*)p);
+            __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                        _mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, newline)));
+            int mask = _mm_movemask_epi8(hits);
+            if (mask != 0) return p + countTrailingZeros64((uint64_t)mask);
+            p += 16;
+        }
+#endif
+        while (p < end && *p != '"' && *p != ',' && *p != '\n') p++;
+        return p;
+    }
+
+    static string_view trimCarriageReturn(const char* first, const char* last) {
+        if (last > first && last[-1] == '\r') last--;
+        return string_view(first, last - first);
+    }
+
+public:
+    CsvReader(const char* data, size_t length) : pos(data), end(data + length) {}
+
+    const char* position() const { return pos; }
+    bool atEnd() const { return pos >= end; }
+
+    // Parse the next record; returns false at end of input
+    bool next(CsvRecord& record) {
+        if (pos >= end) return false;
+
+        const char* lineStart = pos;
+        const char* fieldStart = pos;
+        const char* p = pos;
+        bool inQuotes = false;
+        bool fieldHasQuotes = false;
+        record.fieldCount = 0;
+
+        auto addField = [&](const char* fieldEnd, bool lastField) {
+            if (record.fieldCount >= CsvRecord::MAX_FIELDS) return;
+            CsvField& field = record.fields[record.fieldCount++];
+            field.text = lastField ? trimCarriageReturn(fieldStart, fieldEnd)
+                                   : string_view(fieldStart, fieldEnd - fieldStart);
+            field.hasQuotes = fieldHasQuotes;
+        };
+
+        while (true) {
+            if (inQuotes) {
+                // Inside quotes only the closing quote matters (commas and newlines are data)
+                const char* quote = (const char*)memchr(p, '"', end - p);
+                if (quote == nullptr) {
+                    p = end;
+                } else {
+                    inQuotes = false;
+                    p = quote + 1;
+                    continue;
+                }
+            } else {
+                p = findStructural(p, end);
+            }
+
+            if (p >= end) {
+                addField(end, true);
+                record.line = trimCarriageReturn(lineStart, end);
+                pos = end;
+                return true;
+            }
+            if (*p == '"') {
+                inQuotes = true;
+                fieldHasQuotes = true;
+                p++;
+            } else if (*p == ',') {
+                addField(p, false);
+                fieldStart = ++p;
+                fieldHasQuotes = false;
+            } else { // newline
+                addField(p, true);
+                record.line = trimCarriageReturn(lineStart, p);
+                pos = p + 1;
+                return true;
+            }
+        }
+    }
+};
+
+// Upper bound on the records in [start, stop): one per line (quoted newlines overcount).
+// Used to size record storage before parsing.
+inline size_t countCsvLines(const char* start, const char* stop) {
+    size_t lines = 0;
+    for (const char* p = start; p < stop; p++) {
+        p = (const char*)memchr(p, '\n', stop - p);
+        if (p == nullptr) return lines + 1; // last line without a newline
+        lines++;
+    }
+    return lines;
+}
+
+// Parallel ingestion splits a file into byte ranges of at least this size
+const size_t CSV_MIN_CHUNK_BYTES = 64 * 1024;
+
+// Number of byte ranges to split a file of the given size into
+inline int csvChunkCount(size_t fileSize, int numThreads) {
+    if (numThreads <= 0) numThreads = WorkStealingPool::defaultThreadCount();
+    size_t bySize = fileSize / CSV_MIN_CHUNK_BYTES;
+    int chunks = (int)min((size_t)numThreads, bySize);
+    return chunks > 1 ? chunks : 1;
+}
+
+// Split a CSV buffer into `chunks` ranges that each start at a record boundary.
+// Speculative two-pass scheme:
+//   pass 1 (parallel) - every range counts its quotes and finds its first unquoted newline
+//                       twice: once assuming it starts outside quotes, once assuming inside.
+//                       Neither scan leaves the range, so pass 1 reads the file about 3 times
+//                       in total, split across the threads
+//   pass 2 (serial)   - a prefix XOR of the quote counts gives the real quote state at each
+//                       range start, which picks the right speculative newline; a range with no
+//                       record boundary (inside one long record) merges into its predecessor
+// Returns chunks + 1 pointers; range c is [starts[c], starts[c + 1]) and may be empty.
+inline vector<const char*> findCsvChunkStarts(const char* data, size_t size, int chunks, WorkStealingPool& pool) {
+    struct ChunkScan {
+        size_t quoteCount;
+        const char* firstNewline[2]; // [0] assuming outside quotes, [1] assuming inside; nullptr = none in the range
+    };
+    vector<ChunkScan> scans(chunks);
+    const char* end = data + size;
+
+    pool.parallelFor(0, chunks, 1, [&](int first, int last, int) {
+        for (int c = first; c < last; c++) {
+            const char* rangeStart = data + size * c / chunks;
+            const char* rangeEnd = data + size * (c + 1) / chunks;
+            ChunkScan& scan = scans[c];
+            scan.quoteCount = 0;
+            for (const char* p = rangeStart; p < rangeEnd; p++) {
+                if (*p == '"') scan.quoteCount++;
+            }
+            for (int assumeQuoted = 0; assumeQuoted < 2; assumeQuoted++) {
+                bool inQuotes = assumeQuoted == 1;
+                const char* p = rangeStart;
+                while (p < rangeEnd && (inQuotes || *p != '\n')) {
+                    if (*p == '"') inQuotes = !inQuotes;
+                    p++;
+                }
+                scan.firstNewline[assumeQuoted] = p < rangeEnd ? p : nullptr;
+            }
+        }
+    });
+
+    vector<const char*> starts(chunks + 1);
+    starts[0] = data;
+    starts[chunks] = end;
+    bool inQuotes = false;
+    for (int c = 1; c < chunks; c++) {
+        if (scans[c - 1].quoteCount % 2 == 1) inQuotes = !inQuotes;
+        const char* newline = scans[c].firstNewline[inQuotes ? 1 : 0];
+        starts[c] = newline != nullptr ? newline + 1 : nullptr;
+    }
+    for (int c = chunks - 1; c >= 1; c--) {
+        if (starts[c] == nullptr) starts[c] = starts[c + 1]; // record longer than a range
+    }
+    return starts;
+}
+
+#endif
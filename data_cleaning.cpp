@@ -1,14 +1,23 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <sstream>
+#include <map>
+#include <thread>
 #include <algorithm>
 #include <cctype>
-#include "array.cpp"
+#include <cstdio>
+#include "skills.cpp"
+#include "thread_pool.cpp"
 
 using namespace std;
 
+// Lines per pipeline batch, and how many batches may sit between the reader and the writer.
+// Together they bound the cleaner's memory, whatever the size of the input file.
+const int BATCH_LINES = 4096;
+const int MAX_BATCHES_IN_FLIGHT = 32;
+
 // Helper function to trim whitespace
 static inline string trim(const string &s) {
     size_t start = s.find_first_not_of(" \t\n\r");
@@ -30,149 +39,187 @@ static inline string normalizeTitle(const string &raw) {
     return t;
 }
 
-// Helper function to escape CSV fields
-static inline string csvEscape(const string &s) {
+// Helper function to append a CSV field, quoting it when needed
+static inline void appendCsvField(string &out, const string &s) {
     if (s.find(',') != string::npos || s.find('"') != string::npos || s.find('\n') != string::npos) {
-        string escaped = "\"";
+        out += '"';
         for (char c : s) {
-            if (c == '"') escaped += "\"\"";
-            else escaped += c;
+            if (c == '"') out += "\"\"";
+            else out += c;
         }
-        escaped += "\"";
-        return escaped;
+        out += '"';
+    } else {
+        out += s;
     }
-    return s;
 }
 
-int main() {
-    cout << "Starting data cleaning process..." << endl;
-    
-    // Process job descriptions
-    cout << "Processing job descriptions..." << endl;
-    ifstream jobFile("./data/job_description.csv");
-    if (!jobFile.is_open()) {
-        cerr << "Error: Cannot open job_description.csv" << endl;
-        return 1;
+// Text after marker up to the first period (or end of line); empty if the marker is missing
+static inline string_view extractSkillSpan(const string &line, const char *marker) {
+    size_t markerPos = line.find(marker);
+    if (markerPos == string::npos) return string_view();
+    string_view span = string_view(line).substr(markerPos + char_traits<char>::length(marker));
+    size_t endPos = span.find('.');
+    return endPos == string_view::npos ? span : span.substr(0, endPos);
+}
+
+// Job row: Job_ID,Title,Skills
+static void cleanJobRow(const string &line, int id, string &out) {
+    size_t neededPos = line.find(" needed");
+    string title = neededPos != string::npos ? line.substr(0, neededPos) : "";
+
+    out += to_string(id);
+    out += ',';
+    appendCsvField(out, normalizeTitle(title));
+    out += ',';
+    appendCsvField(out, filterTechnicalSkills(extractSkillSpan(line, "experience in")));
+    out += '\n';
+}
+
+// Resume row: Resume_ID,Skills
+static void cleanResumeRow(const string &line, int id, string &out) {
+    out += to_string(id);
+    out += ',';
+    appendCsvField(out, filterTechnicalSkills(extractSkillSpan(line, "skilled in")));
+    out += '\n';
+}
+
+typedef void (*RowCleaner)(const string &line, int id, string &out);
+
+struct LineBatch {
+    long long sequence;
+    int firstId;            // output ID of lines[0]
+    vector<string> lines;
+};
+
+struct CleanBatch {
+    long long sequence;
+    string text;            // finished CSV rows
+};
+
+// Clean one raw file through a streaming pipeline:
+//   reader (this thread) -> [bounded queue] -> cleaner threads -> [bounded queue] -> writer thread
+// Batches carry sequence numbers so the writer can restore input order. The output is written
+// to a temporary file that replaces outputPath only when everything succeeded.
+static bool cleanFile(const string &inputPath, const string &outputPath, const string &header, RowCleaner cleanRow) {
+    ifstream in(inputPath);
+    if (!in.is_open()) {
+        cerr << "Error: Cannot open " << inputPath << endl;
+        return false;
     }
-    
-    ofstream out("./data/job_description_clean.csv");
+    string tempPath = outputPath + ".tmp";
+    ofstream out(tempPath, ios::trunc);
     if (!out.is_open()) {
-        cerr << "Error: Cannot create job_description_clean.csv" << endl;
-        return 1;
+        cerr << "Error: Cannot create " << tempPath << endl;
+        return false;
     }
-    
-    // Write header
-    out << "Job_ID,Title,Skills\n";
-    
-    string line;
-    int jobId = 1;
-    
-    // Skip header line
-    getline(jobFile, line);
-    
-    while (getline(jobFile, line)) {
-        if (line.empty()) continue;
-        
-        // Create a Job object to use its parsing logic
-        Job job;
-        
-        // Parse the job using the existing logic
-        size_t neededPos = line.find(" needed");
-        if (neededPos != string::npos) {
-            job.title = line.substr(0, neededPos);
-        }
-        
-        // Extract skills from the line
-        string rawSkills = "";
-        size_t expPos = line.find("experience in");
-        if (expPos != string::npos) {
-            rawSkills = line.substr(expPos + 13);
-            // Find the end of the skills (first period or end of line)
-            size_t endPos = rawSkills.find('.');
-            if (endPos != string::npos) {
-                rawSkills = rawSkills.substr(0, endPos);
+
+    int numCleaners = WorkStealingPool::defaultThreadCount();
+    BoundedQueue<LineBatch> lineQueue(numCleaners * 2);
+    BoundedQueue<CleanBatch> cleanQueue(numCleaners * 2);
+    BoundedQueue<char> inFlight(MAX_BATCHES_IN_FLIGHT); // one token per batch not yet written
+    bool writeOk = true;
+
+    vector<thread> cleaners;
+    for (int t = 0; t < numCleaners; t++) {
+        cleaners.emplace_back([&]() {
+            LineBatch batch;
+            while (lineQueue.pop(batch)) {
+                CleanBatch cleaned;
+                cleaned.sequence = batch.sequence;
+                for (size_t i = 0; i < batch.lines.size(); i++) {
+                    cleanRow(batch.lines[i], batch.firstId + (int)i, cleaned.text);
+                }
+                cleanQueue.push(move(cleaned));
+            }
+        });
+    }
+
+    thread writer([&]() {
+        out << header << "\n";
+        map<long long, string> pending; // finished out of order, at most MAX_BATCHES_IN_FLIGHT
+        long long nextSequence = 0;
+        CleanBatch cleaned;
+        while (cleanQueue.pop(cleaned)) {
+            pending[cleaned.sequence] = move(cleaned.text);
+            for (auto it = pending.find(nextSequence); it != pending.end(); it = pending.find(nextSequence)) {
+                out.write(it->second.data(), it->second.size());
+                pending.erase(it);
+                nextSequence++;
+                char token;
+                inFlight.pop(token);
             }
         }
-        
-        // Filter skills using the existing method
-        job.skills = job.filterTechnicalSkills(rawSkills);
-        
-        // Normalize title
-        string titleNorm = normalizeTitle(job.title);
-        
-        // Write to output
-        out << jobId << "," << csvEscape(titleNorm) << "," << csvEscape(job.skills) << "\n";
-        jobId++;
+        out.flush();
+        writeOk = out.good();
+    });
+
+    // Reader: skip the header, batch non-empty lines and number them
+    string line;
+    getline(in, line);
+    long long sequence = 0;
+    int nextId = 1;
+    LineBatch batch;
+    batch.lines.reserve(BATCH_LINES);
+    auto dispatch = [&]() {
+        batch.sequence = sequence++;
+        batch.firstId = nextId;
+        nextId += (int)batch.lines.size();
+        inFlight.push(0); // waits while the writer is MAX_BATCHES_IN_FLIGHT batches behind
+        lineQueue.push(move(batch));
+        batch = LineBatch();
+        batch.lines.reserve(BATCH_LINES);
+    };
+    while (getline(in, line)) {
+        if (line.empty()) continue;
+        batch.lines.push_back(move(line));
+        if ((int)batch.lines.size() == BATCH_LINES) dispatch();
     }
-    
-    jobFile.close();
+    if (!batch.lines.empty()) dispatch();
+
+    lineQueue.close();
+    for (thread &cleaner : cleaners) cleaner.join();
+    cleanQueue.close();
+    writer.join();
     out.close();
-    
-    // Atomic file replacement
-    if (rename("./data/job_description_clean.csv.tmp", "./data/job_description_clean.csv") != 0) {
-        // If rename fails, the file is already in place
+
+    if (!writeOk) {
+        cerr << "Error: Failed writing " << tempPath << endl;
+        remove(tempPath.c_str());
+        return false;
+    }
+#ifdef _WIN32
+    remove(outputPath.c_str()); // rename does not replace an existing file on Windows
+#endif
+    if (rename(tempPath.c_str(), outputPath.c_str()) != 0) {
+        cerr << "Error: Cannot replace " << outputPath << endl;
+        return false;
+    }
+    return true;
+}
+
+int main() {
+    cout << "Starting data cleaning process..." << endl;
+
+    // Skills are kept (and written in canonical form) by the same taxonomy the program loads
+    string taxonomyPath = "./data/skill_taxonomy.cfg";
+    if (skillDictionary.loadTaxonomy(taxonomyPath)) {
+        cout << "Skill taxonomy: " << skillDictionary.size() << " skills from " << taxonomyPath << endl;
+    }
+
+    // Process job descriptions
+    cout << "Processing job descriptions..." << endl;
+    if (!cleanFile("./data/job_description.csv", "./data/job_description_clean.csv", "Job_ID,Title,Skills", cleanJobRow)) {
+        return 1;
     }
-    
     cout << "Wrote cleaned jobs to: ./data/job_description_clean.csv" << endl;
-    
+
     // Process resumes
     cout << "Processing resumes..." << endl;
-    ifstream resumeFile("./data/resume.csv");
-    if (!resumeFile.is_open()) {
-        cerr << "Error: Cannot open resume.csv" << endl;
-        return 1;
-    }
-    
-    ofstream rout("./data/resume_clean.csv");
-    if (!rout.is_open()) {
-        cerr << "Error: Cannot create resume_clean.csv" << endl;
+    if (!cleanFile("./data/resume.csv", "./data/resume_clean.csv", "Resume_ID,Skills", cleanResumeRow)) {
         return 1;
     }
-    
-    // Write header
-    rout << "Resume_ID,Skills\n";
-    
-    int resumeId = 1;
-    
-    // Skip header line
-    getline(resumeFile, line);
-    
-    while (getline(resumeFile, line)) {
-        if (line.empty()) continue;
-        
-        // Create a Resume object to use its parsing logic
-        Resume r;
-        
-        // Extract skills from the line
-        string rawSkills = "";
-        size_t skilledPos = line.find("skilled in");
-        if (skilledPos != string::npos) {
-            rawSkills = line.substr(skilledPos + 10);
-            // Find the end of the skills (first period or end of line)
-            size_t endPos = rawSkills.find('.');
-            if (endPos != string::npos) {
-                rawSkills = rawSkills.substr(0, endPos);
-            }
-        }
-        
-        // Filter skills using the existing method
-        r.skills = r.filterTechnicalSkills(rawSkills);
-        
-        // Write to output
-        rout << resumeId << "," << csvEscape(r.skills) << "\n";
-        resumeId++;
-    }
-    
-    resumeFile.close();
-    rout.close();
-    
-    // Atomic file replacement
-    if (rename("./data/resume_clean.csv.tmp", "./data/resume_clean.csv") != 0) {
-        // If rename fails, the file is already in place
-    }
-    
     cout << "Wrote cleaned resumes to: ./data/resume_clean.csv" << endl;
-    
+
     cout << "Data cleaning completed successfully!" << endl;
     return 0;
 }
@@ -0,0 +1,581 @@
+#ifndef LIVE_INDEX_CPP
+#define LIVE_INDEX_CPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include "posting_index.cpp"
+#include "set_ops.cpp"
+#include "roaring.cpp"
+#include "snapshot.cpp"
+using namespace std;
+
+// Fields every document is indexed under
+enum IndexField { FIELD_SKILL = 0, FIELD_TITLE = 1, FIELD_DESCRIPTION = 2 };
+const int NUM_INDEX_FIELDS = 3;
+
+// Index terms of one document, per field. The terms are views: into the skill dictionary or
+// into the scratch arena of whoever collected them, and only valid until that arena is reset.
+struct DocumentTerms {
+    vector<string_view> fields[NUM_INDEX_FIELDS];
+
+    void clear() {
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) fields[f].clear();
+    }
+};
+
+// Sorted in-memory posting lists of the mutable segment
+class DeltaPostings {
+private:
+    unordered_map<string, DocIdList> lists;
+    size_t postingCount;
+
+public:
+    DeltaPostings() : postingCount(0) {}
+
+    size_t size() const { return postingCount; }
+    const unordered_map<string, DocIdList>& getLists() const { return lists; }
+
+    void add(string_view term, int docId) {
+        DocIdList& docs = lists[string(term)];
+        auto it = lower_bound(docs.begin(), docs.end(), docId); // new documents append at the end
+        if (it != docs.end() && *it == docId) return;
+        docs.insert(it, docId);
+        postingCount++;
+    }
+
+    void remove(string_view term, int docId) {
+        auto found = lists.find(string(term));
+        if (found == lists.end()) return;
+        DocIdList& docs = found->second;
+        auto it = lower_bound(docs.begin(), docs.end(), docId);
+        if (it == docs.end() || *it != docId) return;
+        docs.erase(it);
+        postingCount--;
+        if (docs.empty()) lists.erase(found);
+    }
+
+    // Postings of a term, or nullptr
+    const DocIdList* find(const string& term) const {
+        auto found = lists.find(term);
+        return found == lists.end() ? nullptr : &found->second;
+    }
+
+    void clear() {
+        lists.clear();
+        postingCount = 0;
+    }
+};
+
+// One sealed, immutable part of the index
+struct IndexSegment {
+    int segmentId;
+    DocIdList docIds;                        // documents indexed in this segment (sorted)
+    PostingIndex fields[NUM_INDEX_FIELDS];
+    RoaringIndex skillBitmaps;               // bitmaps of fields[FIELD_SKILL]
+
+    size_t postingCount() const {
+        size_t total = 0;
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) total += fields[f].getPostingCount();
+        return total;
+    }
+};
+
+// Segmented (LSM-style) inverted index with stable document IDs, kept current under
+// insert, update and delete.
+//   mutable segment - sorted in-memory postings that take every new or changed document
+//   sealed segments - immutable compact indexes; the mutable segment is sealed once it
+//                     holds SEAL_POSTINGS postings
+// Every document is owned by exactly one segment (or none once deleted). Postings of a
+// document in any other segment are tombstones and are filtered out at query time, so an
+// update only touches the mutable segment. A background thread merges sealed segments of
+// similar size (MERGE_FACTOR at a time) and rewrites segments that are mostly tombstones;
+// queries keep running on the old segments until a merge is installed.
+class LiveIndex {
+private:
+    static constexpr int NO_SEGMENT = -1;
+    static constexpr size_t SEAL_POSTINGS = 16384;
+    static constexpr int MERGE_FACTOR = 4;
+
+    // A sealed segment plus the bookkeeping that changes after sealing
+    struct SegmentSlot {
+        shared_ptr<const IndexSegment> segment;
+        int staleDocs;                       // documents of the segment owned elsewhere (or deleted)
+        mutable mutex cacheLock;
+        mutable RoaringBitmap staleBitmap;   // cached for skill queries
+        mutable bool staleBitmapValid;
+
+        SegmentSlot(shared_ptr<const IndexSegment> s) : segment(move(s)), staleDocs(0), staleBitmapValid(false) {}
+    };
+
+    mutable shared_mutex stateLock;          // queries: shared, changes and installs: exclusive
+    vector<unique_ptr<SegmentSlot>> sealed;
+    DeltaPostings mutableFields[NUM_INDEX_FIELDS];
+    DocIdList mutableDocs;                   // documents added to the mutable segment (sorted)
+    int mutableSegmentId;
+    int nextSegmentId;
+    vector<int32_t> owner;                   // segment ID owning each document ID
+
+    // Background merging
+    mutex mergeLock;                         // held while a merge is built and installed
+    mutex workLock;
+    condition_variable workAvailable;
+    bool mergeRequested;
+    bool stopping;
+    thread merger;
+
+    bool isLiveIn(int docId, int segmentId) const { return owner[docId] == segmentId; }
+
+    SegmentSlot* findSlot(int segmentId) const {
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            if (slot->segment->segmentId == segmentId) return slot.get();
+        }
+        return nullptr;
+    }
+
+    const RoaringBitmap& staleDocs(const SegmentSlot& slot) const {
+        lock_guard<mutex> guard(slot.cacheLock);
+        if (!slot.staleBitmapValid) {
+            DocIdList stale;
+            for (int docId : slot.segment->docIds) {
+                if (!isLiveIn(docId, slot.segment->segmentId)) stale.push_back(docId);
+            }
+            slot.staleBitmap = RoaringBitmap::fromSorted(stale.begin(), stale.end());
+            slot.staleBitmapValid = true;
+        }
+        return slot.staleBitmap;
+    }
+
+    // A document leaves the segment that owned it (caller holds stateLock exclusively)
+    void release(int docId, const DocumentTerms* oldTerms) {
+        int from = owner[docId];
+        if (from == mutableSegmentId) {
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+                for (string_view term : oldTerms->fields[f]) mutableFields[f].remove(term, docId);
+            }
+        } else if (SegmentSlot* slot = findSlot(from)) {
+            slot->staleDocs++; // its postings there become tombstones
+            lock_guard<mutex> guard(slot->cacheLock);
+            slot->staleBitmapValid = false;
+        }
+        owner[docId] = NO_SEGMENT;
+    }
+
+    static shared_ptr<IndexSegment> makeSegment(int segmentId, DocIdList docIds, PostingIndexBuilder builders[NUM_INDEX_FIELDS]) {
+        shared_ptr<IndexSegment> segment = make_shared<IndexSegment>();
+        segment->segmentId = segmentId;
+        segment->docIds = move(docIds);
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) segment->fields[f] = builders[f].build();
+        segment->skillBitmaps = RoaringIndex(segment->fields[FIELD_SKILL]);
+        return segment;
+    }
+
+    // Turn the mutable segment into a sealed one (caller holds stateLock exclusively)
+    void sealMutable() {
+        DocIdList docs;
+        for (int docId : mutableDocs) {
+            if (isLiveIn(docId, mutableSegmentId)) docs.push_back(docId);
+        }
+        if (!docs.empty()) {
+            PostingIndexBuilder builders[NUM_INDEX_FIELDS];
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+                for (const auto& entry : mutableFields[f].getLists()) {
+                    for (int docId : entry.second) builders[f].add(entry.first, docId);
+                }
+            }
+            // The sealed segment keeps the mutable segment's ID, so no owner changes
+            sealed.emplace_back(new SegmentSlot(makeSegment(mutableSegmentId, move(docs), builders)));
+        }
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) mutableFields[f].clear();
+        mutableDocs.clear();
+        mutableSegmentId = nextSegmentId++;
+    }
+
+    static int sizeTier(const IndexSegment& segment) {
+        int tier = 0;
+        size_t threshold = SEAL_POSTINGS * MERGE_FACTOR;
+        for (size_t postings = segment.postingCount(); postings >= threshold; threshold *= MERGE_FACTOR) tier++;
+        return tier;
+    }
+
+    // Segments to merge next: MERGE_FACTOR segments of the smallest crowded size tier, or a
+    // single segment that is mostly tombstones (caller holds stateLock)
+    vector<shared_ptr<const IndexSegment>> pickMerge() const {
+        vector<shared_ptr<const IndexSegment>> inputs;
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            if (slot->staleDocs * 2 > (int)slot->segment->docIds.size()) {
+                inputs.push_back(slot->segment);
+                return inputs;
+            }
+        }
+        unordered_map<int, vector<shared_ptr<const IndexSegment>>> tiers;
+        int bestTier = -1;
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            int tier = sizeTier(*slot->segment);
+            tiers[tier].push_back(slot->segment);
+            if ((int)tiers[tier].size() >= MERGE_FACTOR && (bestTier < 0 || tier < bestTier)) bestTier = tier;
+        }
+        if (bestTier >= 0) {
+            inputs = tiers[bestTier];
+            inputs.resize(MERGE_FACTOR);
+        }
+        return inputs;
+    }
+
+    // Merge sealed segments into one, dropping tombstones. The new segment is built without
+    // holding stateLock; only reading the live documents and installing the result lock it.
+    // Caller holds mergeLock.
+    void mergeSegments(const vector<shared_ptr<const IndexSegment>>& inputs) {
+        if (inputs.empty()) return;
+
+        // Live documents of every input, tagged with the input they come from
+        vector<DocIdList> liveDocs(inputs.size());
+        int newSegmentId;
+        int maxDocId = -1;
+        {
+            shared_lock<shared_mutex> guard(stateLock);
+            for (size_t i = 0; i < inputs.size(); i++) {
+                for (int docId : inputs[i]->docIds) {
+                    if (isLiveIn(docId, inputs[i]->segmentId)) liveDocs[i].push_back(docId);
+                }
+                if (!inputs[i]->docIds.empty()) maxDocId = max(maxDocId, inputs[i]->docIds.back());
+            }
+        }
+        {
+            unique_lock<shared_mutex> guard(stateLock);
+            newSegmentId = nextSegmentId++;
+        }
+
+        vector<uint32_t> source(maxDocId + 1, 0); // 1 + index of the input a live document comes from
+        DocIdList mergedDocs;
+        for (size_t i = 0; i < inputs.size(); i++) {
+            for (int docId : liveDocs[i]) source[docId] = (uint32_t)(i + 1);
+            mergedDocs.insert(mergedDocs.end(), liveDocs[i].begin(), liveDocs[i].end());
+        }
+        sort(mergedDocs.begin(), mergedDocs.end());
+
+        PostingIndexBuilder builders[NUM_INDEX_FIELDS];
+        for (size_t i = 0; i < inputs.size(); i++) {
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+                const PostingIndex& postings = inputs[i]->fields[f];
+                for (int t = 0; t < postings.getTermCount(); t++) {
+                    string_view term = postings.getTerm(t);
+                    for (int docId : postings.getPostings(t)) {
+                        if (source[docId] == i + 1) builders[f].add(term, docId);
+                    }
+                }
+            }
+        }
+        shared_ptr<IndexSegment> merged = makeSegment(newSegmentId, move(mergedDocs), builders);
+
+        // Install: documents changed while we were merging stay with their new owner
+        unique_lock<shared_mutex> guard(stateLock);
+        unique_ptr<SegmentSlot> slot(new SegmentSlot(merged));
+        for (size_t i = 0; i < inputs.size(); i++) {
+            for (int docId : liveDocs[i]) {
+                if (isLiveIn(docId, inputs[i]->segmentId)) owner[docId] = newSegmentId;
+                else slot->staleDocs++;
+            }
+        }
+        sealed.erase(remove_if(sealed.begin(), sealed.end(), [&](const unique_ptr<SegmentSlot>& s) {
+            return find(inputs.begin(), inputs.end(), s->segment) != inputs.end();
+        }), sealed.end());
+        if (!merged->docIds.empty()) sealed.push_back(move(slot));
+    }
+
+    void mergeLoop() {
+        while (true) {
+            {
+                unique_lock<mutex> guard(workLock);
+                workAvailable.wait(guard, [this] { return stopping || mergeRequested; });
+                if (stopping) return;
+                mergeRequested = false;
+            }
+            // Keep merging while the policy finds work
+            while (true) {
+                lock_guard<mutex> merging(mergeLock);
+                vector<shared_ptr<const IndexSegment>> inputs;
+                {
+                    shared_lock<shared_mutex> guard(stateLock);
+                    inputs = pickMerge();
+                }
+                if (inputs.empty()) break;
+                mergeSegments(inputs);
+                lock_guard<mutex> guard(workLock);
+                if (stopping) return;
+            }
+        }
+    }
+
+    // Wake the merge thread (started on first use)
+    void requestMerge() {
+        lock_guard<mutex> guard(workLock);
+        if (!merger.joinable()) merger = thread(&LiveIndex::mergeLoop, this);
+        mergeRequested = true;
+        workAvailable.notify_one();
+    }
+
+    void stopMerger() {
+        {
+            lock_guard<mutex> guard(workLock);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        if (merger.joinable()) merger.join();
+        stopping = false;
+        mergeRequested = false;
+    }
+
+    // Intersection of the given lists (smallest first)
+    static DocIdList intersectLists(vector<DocIdList>& lists) {
+        sort(lists.begin(), lists.end(), [](const DocIdList& a, const DocIdList& b) { return a.size() < b.size(); });
+        DocIdList result = lists[0];
+        DocIdList intersection;
+        for (size_t k = 1; k < lists.size() && !result.empty(); k++) {
+            intersection.resize(result.size());
+            int count = intersectSorted(result.data(), (int)result.size(), lists[k].data(), (int)lists[k].size(), intersection.data());
+            intersection.resize(count);
+            result.swap(intersection);
+        }
+        return result;
+    }
+
+public:
+    LiveIndex() : mutableSegmentId(0), nextSegmentId(1), mergeRequested(false), stopping(false) {}
+    ~LiveIndex() { stopMerger(); }
+
+    LiveIndex(const LiveIndex&) = delete;
+    LiveIndex& operator=(const LiveIndex&) = delete;
+
+    // Drop everything
+    void clear() {
+        stopMerger();
+        unique_lock<shared_mutex> guard(stateLock);
+        sealed.clear();
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) mutableFields[f].clear();
+        mutableDocs.clear();
+        owner.clear();
+        mutableSegmentId = 0;
+        nextSegmentId = 1;
+    }
+
+    // Bulk build over document IDs [0, docCount) into a single sealed segment.
+    // collect(docId, terms) fills the terms of a document and returns false for deleted IDs.
+    template<typename Collector>
+    void rebuild(int docCount, Collector collect) {
+        clear();
+        PostingIndexBuilder builders[NUM_INDEX_FIELDS];
+        DocIdList docs;
+        DocumentTerms terms;
+        int segmentId = nextSegmentId++;
+        owner.assign(docCount, NO_SEGMENT);
+        docs.reserve(docCount);
+        for (int docId = 0; docId < docCount; docId++) {
+            terms.clear();
+            if (!collect(docId, terms)) continue;
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+                for (string_view term : terms.fields[f]) builders[f].add(term, docId);
+            }
+            owner[docId] = segmentId;
+            docs.push_back(docId);
+        }
+        unique_lock<shared_mutex> guard(stateLock);
+        sealed.emplace_back(new SegmentSlot(makeSegment(segmentId, move(docs), builders)));
+        mutableSegmentId = nextSegmentId++;
+    }
+
+    // Index a new document, or the new version of a document removed with removeDocument
+    void addDocument(int docId, const DocumentTerms& terms) {
+        bool sealedOne = false;
+        {
+            unique_lock<shared_mutex> guard(stateLock);
+            if (docId >= (int)owner.size()) owner.resize(docId + 1, NO_SEGMENT);
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+                for (string_view term : terms.fields[f]) mutableFields[f].add(term, docId);
+            }
+            owner[docId] = mutableSegmentId;
+            if (mutableDocs.empty() || mutableDocs.back() < docId) mutableDocs.push_back(docId);
+            else mutableDocs.insert(lower_bound(mutableDocs.begin(), mutableDocs.end(), docId), docId);
+            mutableDocs.erase(unique(mutableDocs.begin(), mutableDocs.end()), mutableDocs.end());
+
+            size_t mutablePostings = 0;
+            for (int f = 0; f < NUM_INDEX_FIELDS; f++) mutablePostings += mutableFields[f].size();
+            if (mutablePostings >= SEAL_POSTINGS) {
+                sealMutable();
+                sealedOne = true;
+            }
+        }
+        if (sealedOne) requestMerge();
+    }
+
+    // Drop a document; oldTerms must be the terms it was indexed with
+    void removeDocument(int docId, const DocumentTerms& oldTerms) {
+        bool mostlyStale = false;
+        {
+            unique_lock<shared_mutex> guard(stateLock);
+            if (docId < 0 || docId >= (int)owner.size() || owner[docId] == NO_SEGMENT) return;
+            int from = owner[docId];
+            release(docId, &oldTerms);
+            SegmentSlot* slot = findSlot(from);
+            mostlyStale = slot != nullptr && slot->staleDocs * 2 > (int)slot->segment->docIds.size();
+        }
+        if (mostlyStale) requestMerge();
+    }
+
+    // Seal the mutable segment and merge everything into one segment (synchronously)
+    void compact() {
+        lock_guard<mutex> merging(mergeLock);
+        vector<shared_ptr<const IndexSegment>> inputs;
+        {
+            unique_lock<shared_mutex> guard(stateLock);
+            sealMutable();
+            bool clean = sealed.size() == 1 && sealed[0]->staleDocs == 0;
+            if (clean || sealed.empty()) return;
+            for (const unique_ptr<SegmentSlot>& slot : sealed) inputs.push_back(slot->segment);
+        }
+        mergeSegments(inputs);
+    }
+
+    int getSegmentCount() const {
+        shared_lock<shared_mutex> guard(stateLock);
+        return (int)sealed.size() + (mutableDocs.empty() ? 0 : 1);
+    }
+
+    // Documents with an exact skill term: fan out over the segments, OR the live parts
+    RoaringBitmap lookupSkill(const string& term) const {
+        shared_lock<shared_mutex> guard(stateLock);
+        vector<RoaringBitmap> parts;
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            const RoaringBitmap& postings = slot->segment->skillBitmaps.lookup(term);
+            if (postings.empty()) continue;
+            parts.push_back(slot->staleDocs > 0 ? RoaringBitmap::andNotOf(postings, staleDocs(*slot)) : postings);
+        }
+        const DocIdList* added = mutableFields[FIELD_SKILL].find(term);
+        if (added != nullptr) parts.push_back(RoaringBitmap::fromSorted(added->begin(), added->end()));
+
+        if (parts.empty()) return RoaringBitmap();
+        if (parts.size() == 1) return parts[0];
+        vector<const RoaringBitmap*> inputs;
+        for (const RoaringBitmap& part : parts) inputs.push_back(&part);
+        return RoaringBitmap::orMany(inputs);
+    }
+
+    // Documents with any of the skill terms (OR). The stored bitmaps of each segment are OR'ed in
+    // place and the segment's tombstones removed once, so no term's postings are copied.
+    RoaringBitmap lookupAnySkill(const vector<string_view>& terms) const {
+        if (terms.empty()) return RoaringBitmap();
+        shared_lock<shared_mutex> guard(stateLock);
+        vector<RoaringBitmap> parts;
+        vector<const RoaringBitmap*> inputs;
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            inputs.clear();
+            for (string_view term : terms) {
+                const RoaringBitmap& postings = slot->segment->skillBitmaps.lookup(term);
+                if (!postings.empty()) inputs.push_back(&postings);
+            }
+            if (inputs.empty()) continue;
+            RoaringBitmap segmentDocs = RoaringBitmap::orMany(inputs);
+            parts.push_back(slot->staleDocs > 0 ? RoaringBitmap::andNotOf(segmentDocs, staleDocs(*slot)) : move(segmentDocs));
+        }
+        for (string_view term : terms) {
+            const DocIdList* added = mutableFields[FIELD_SKILL].find(string(term));
+            if (added != nullptr) parts.push_back(RoaringBitmap::fromSorted(added->begin(), added->end()));
+        }
+
+        if (parts.empty()) return RoaringBitmap();
+        if (parts.size() == 1) return move(parts[0]);
+        inputs.clear();
+        for (const RoaringBitmap& part : parts) inputs.push_back(&part);
+        return RoaringBitmap::orMany(inputs);
+    }
+
+    // Documents containing every term (AND) in one field. A document's live postings are all in
+    // the segment that owns it, so each segment is intersected on its own and the results are OR'ed.
+    DocIdList lookupAll(IndexField field, const vector<string>& terms) const {
+        if (terms.empty()) return DocIdList();
+        shared_lock<shared_mutex> guard(stateLock);
+
+        DocIdList result;
+        for (const unique_ptr<SegmentSlot>& slot : sealed) {
+            const IndexSegment& segment = *slot->segment;
+            vector<PostingSpan> postingLists;
+            for (const string& term : terms) {
+                PostingSpan postings = segment.fields[field].lookup(term);
+                if (postings.empty()) break; // No matches in this segment if any term not found
+                postingLists.push_back(postings);
+            }
+            if (postingLists.size() < terms.size()) continue;
+            DocIdList matches = intersectPostings(postingLists);
+            for (int docId : matches) {
+                if (slot->staleDocs == 0 || isLiveIn(docId, segment.segmentId)) result.push_back(docId);
+            }
+        }
+
+        vector<DocIdList> mutableLists;
+        for (const string& term : terms) {
+            const DocIdList* postings = mutableFields[field].find(term);
+            if (postings == nullptr) break;
+            mutableLists.push_back(*postings);
+        }
+        if (mutableLists.size() == terms.size()) {
+            DocIdList matches = intersectLists(mutableLists);
+            result.insert(result.end(), matches.begin(), matches.end());
+        }
+
+        if (sealed.size() > 1 || !mutableDocs.empty()) sort(result.begin(), result.end());
+        return result;
+    }
+
+    // Snapshot support: everything is compacted into one segment, which is stored as
+    // three PostingIndexes plus a live flag per document ID
+    void writeTo(SnapshotWriter& out) {
+        compact();
+        shared_lock<shared_mutex> guard(stateLock);
+        const IndexSegment* segment = sealed.empty() ? nullptr : sealed[0]->segment.get();
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+            (segment != nullptr ? segment->fields[f] : PostingIndex()).writeTo(out);
+        }
+        vector<uint8_t> live(owner.size(), 0);
+        for (size_t docId = 0; docId < owner.size(); docId++) {
+            live[docId] = segment != nullptr && owner[docId] == segment->segmentId ? 1 : 0;
+        }
+        out.putArray(live);
+    }
+
+    bool readFrom(SnapshotReader& in) {
+        clear();
+        PostingIndex fields[NUM_INDEX_FIELDS];
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) {
+            if (!fields[f].readFrom(in)) return false;
+        }
+        vector<uint8_t> live;
+        if (!in.getArray(live)) return false;
+
+        unique_lock<shared_mutex> guard(stateLock);
+        shared_ptr<IndexSegment> segment = make_shared<IndexSegment>();
+        segment->segmentId = nextSegmentId++;
+        owner.assign(live.size(), NO_SEGMENT);
+        for (size_t docId = 0; docId < live.size(); docId++) {
+            if (live[docId] > 1) return false;
+            if (live[docId]) {
+                owner[docId] = segment->segmentId;
+                segment->docIds.push_back((int)docId);
+            }
+        }
+        for (int f = 0; f < NUM_INDEX_FIELDS; f++) segment->fields[f] = move(fields[f]);
+        segment->skillBitmaps = RoaringIndex(segment->fields[FIELD_SKILL]);
+        sealed.emplace_back(new SegmentSlot(segment));
+        mutableSegmentId = nextSegmentId++;
+        return true;
+    }
+};
+
+#endif
@@ -1,13 +1,18 @@
-#include "array.cpp"
+#include "batch.cpp"
+#include "server.cpp"
 #include <iostream>
 #include <limits>
 #include <chrono>
 #include <iomanip>
+#include <future>
 using namespace std;
 
 // Function declarations
 int countWords(const string& text);
 bool runDataCleaning();
+bool loadDatasets(Array<Job>& jobStorage, Array<Resume>& resumeStorage);
+bool chooseReportSink(ResultSink& sink, string& reportPath);
+void finishReport(ResultSink& sink, const string& reportPath);
 
 
 // Helper function to count words in a string
@@ -51,34 +56,143 @@ bool runDataCleaning() {
     }
 }
 
-int main() {
-    Array<Job> jobStorage(100);
-    Array<Resume> resumeStorage(100);
+// Ask where a matcher report goes: the screen, the screen without per-result lines, or a file
+bool chooseReportSink(ResultSink& sink, string& reportPath) {
+    int outputOption;
+    cout << "\nSelect output:\n";
+    cout << "1. Screen (all results)\n";
+    cout << "2. Screen (summary only)\n";
+    cout << "3. File\n";
+    cout << "Enter your choice (1-3): ";
+    cin >> outputOption;
+    
+    if (cin.fail() || outputOption < 1 || outputOption > 3) {
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        cout << "Invalid choice. Showing all results on screen.\n";
+        outputOption = 1;
+    }
+    
+    reportPath = "-";
+    if (outputOption == 3) {
+        cout << "Enter output file path: ";
+        cin >> ws;
+        getline(cin, reportPath);
+    }
+    if (!sink.open(reportPath, outputOption == 2)) {
+        cerr << "Error: Cannot create " << reportPath << endl;
+        return false;
+    }
+    return true;
+}
 
-    cout << "=========================================\n";
-    cout << "   Job Matching System (Rule-Based)\n";
-    cout << "   Using Custom Array Data Structures\n";
-    cout << "=========================================\n";
+// Close a report sink, telling the user where a file report went
+void finishReport(ResultSink& sink, const string& reportPath) {
+    bool written = sink.close();
+    if (reportPath == "-") return;
+    if (written) cout << "Results written to " << reportPath << endl;
+    else cerr << "Error: Failed writing " << reportPath << endl;
+}
 
-    // ===== Step 1: Auto-load datasets =====
+// Load both datasets (from the snapshot when it is fresh) and prepare the scoring model
+bool loadDatasets(Array<Job>& jobStorage, Array<Resume>& resumeStorage) {
     string jobPath = "./data/job_description_clean.csv";
     string resumePath = "./data/resume_clean.csv";
+    string snapshotPath = "./data/jobmatch.snap";
 
-    cout << "\nLoading job and resume datasets...\n";
+    // Optional skill taxonomy (skills, aliases, hierarchy) in place of the built-in whitelist;
+    // it decides how skill text is encoded, so it is loaded before any record
+    string taxonomyPath = "./data/skill_taxonomy.cfg";
+    if (skillDictionary.loadTaxonomy(taxonomyPath)) {
+        cout << "Skill taxonomy: " << skillDictionary.size() << " skills, " << skillDictionary.getAliasCount()
+             << " aliases from " << taxonomyPath << endl;
+    }
+
+    // Prefer the binary snapshot (records + prebuilt indexes) while it is newer than both CSVs
+    if (isSnapshotFresh(snapshotPath, {jobPath, resumePath}) && loadSnapshot(snapshotPath, jobStorage, resumeStorage)) {
+        cout << "\nLoaded job and resume datasets from snapshot " << snapshotPath << "\n";
+    } else {
+        cout << "\nLoading job and resume datasets...\n";
 
-    bool jobLoaded = jobStorage.loadFromCSV(jobPath);
-    bool resumeLoaded = resumeStorage.loadFromCSV(resumePath);
+        // Load both files at the same time (each load also splits its file across threads)
+        future<bool> jobLoad = async(launch::async, [&]() { return jobStorage.loadFromCSV(jobPath); });
+        bool resumeLoaded = resumeStorage.loadFromCSV(resumePath);
+        bool jobLoaded = jobLoad.get();
 
-    if (!jobLoaded || !resumeLoaded) {
-        cerr << "\nError: Failed to load one or more datasets.\n";
-        cerr << "Please ensure the CSV files exist in ./data/ folder.\n";
-        return 1;
+        if (!jobLoaded || !resumeLoaded) {
+            cerr << "\nError: Failed to load one or more datasets.\n";
+            cerr << "Please ensure the CSV files exist in ./data/ folder.\n";
+            return false;
+        }
+
+        // Cache the parsed data for the next start (a failure here only costs start-up time)
+        if (!saveSnapshot(snapshotPath, jobStorage, resumeStorage)) {
+            cerr << "Warning: Unable to write snapshot " << snapshotPath << "\n";
+        }
     }
 
     cout << "\nSuccessfully loaded datasets!\n";
     cout << "Jobs loaded: " << jobStorage.getSize() << endl;
     cout << "Resumes loaded: " << resumeStorage.getSize() << endl;
 
+    // Scoring model: optional per-skill weights, IDF precomputed from the loaded corpus
+    string weightsPath = "./data/skill_weights.cfg";
+    if (scoringModel.loadWeights(weightsPath)) {
+        cout << "Skill weights: " << scoringModel.getConfiguredCount() << " from " << weightsPath << endl;
+    }
+    scoringModel.prepare(jobStorage.getSkillMatrix(), resumeStorage.getSkillMatrix());
+    cout << "Scoring model: " << scoringModel.name() << endl;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Array<Job> jobStorage(100);
+    Array<Resume> resumeStorage(100);
+
+    // ===== Server mode: --serve SOCKET_PATH or --port PORT =====
+    if (isServerInvocation(argc, argv)) {
+        ServerOptions options;
+        string error;
+        if (!parseServerOptions(argc, argv, options, error)) {
+            cerr << "Error: " << error << "\n";
+            printServerUsage(cerr);
+            return 2;
+        }
+        if (!loadDatasets(jobStorage, resumeStorage)) return 1;
+        return runServer(options, jobStorage, resumeStorage);
+    }
+
+    // ===== Batch mode: any other command-line option =====
+    if (argc > 1) {
+        BatchOptions options;
+        string error;
+        if (!parseBatchOptions(argc, argv, options, error)) {
+            cerr << "Error: " << error << "\n";
+            printBatchUsage(cerr);
+            return 2;
+        }
+        if (options.showHelp) {
+            printBatchUsage(cout);
+            return 0;
+        }
+        // Results may go to stdout, so every status message goes to stderr
+        cout.rdbuf(cerr.rdbuf());
+        if (!loadDatasets(jobStorage, resumeStorage)) return 1;
+        return runBatch(options, jobStorage, resumeStorage);
+    }
+
+    cout << "=========================================\n";
+    cout << "   Job Matching System (Rule-Based)\n";
+    cout << "   Using Custom Array Data Structures\n";
+    cout << "=========================================\n";
+
+    // ===== Step 1: Auto-load datasets =====
+    if (!loadDatasets(jobStorage, resumeStorage)) return 1;
+
+    // Search results go straight to the screen; matcher reports ask where to go
+    ResultSink console;
+    console.open("-");
+
     // ===== Step 2: Interactive Menu =====
     int choice;
     string keyword;
@@ -90,8 +204,10 @@ int main() {
         cout << "2. Search Jobs by Skills\n";
         cout << "3. Search Resumes by Skills\n";
         cout << "4. Show Best Matches for Each Job\n";
-        cout << "5. Clean Data (Regenerate Cleaned CSVs)\n";
-        cout << "6. Exit\n";
+        cout << "5. Show Best Jobs for Each Resume\n";
+        cout << "6. Global Assignment (One Resume per Job)\n";
+        cout << "7. Clean Data (Regenerate Cleaned CSVs)\n";
+        cout << "8. Exit\n";
         cout << "-----------------------------------------\n";
         cout << "Enter choice: ";
         cin >> choice;
@@ -127,7 +243,7 @@ int main() {
                 }
                 
                 cout << "\n=== Job Title Search Results ===" << endl;
-                jobStorage.displayMatchesByTitle(keyword, maxResults);
+                jobStorage.displayMatchesByTitle(keyword, maxResults, console);
                 break;
             }
 
@@ -160,7 +276,7 @@ int main() {
                 }
                 
                 cout << "\n=== Job Search Results ===" << endl;
-                jobStorage.displayMatches(keyword, maxResults);
+                jobStorage.displayMatches(keyword, maxResults, console);
                 break;
             }
 
@@ -193,7 +309,7 @@ int main() {
                 }
                 
                 cout << "\n=== Resume Search Results ===" << endl;
-                resumeStorage.displayMatches(keyword, maxResults);
+                resumeStorage.displayMatches(keyword, maxResults, console);
                 break;
             }
 
@@ -228,12 +344,144 @@ int main() {
                 
                 maxJobsToShow = min(maxJobsToShow, jobStorage.getSize());
                 
+                // Thread count for the parallel matcher
+                int numThreads;
+                cout << "Enter number of threads (0 = all " << WorkStealingPool::defaultThreadCount() << " cores): ";
+                cin >> numThreads;
+                
+                if (cin.fail() || numThreads < 0) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid thread count. Using all cores.\n";
+                    numThreads = 0;
+                }
+                
+                ResultSink report;
+                string reportPath;
+                if (!chooseReportSink(report, reportPath)) break;
+                
                 // Use the new optimized function with all advanced algorithms
-                jobStorage.findBestMatchesForJobs(resumeStorage, maxJobsToShow);
+                jobStorage.findBestMatchesForJobs(resumeStorage, maxJobsToShow, report, numThreads);
+                finishReport(report, reportPath);
                 break;
             }
 
             case 5: {
+                cout << "\n=== Best Jobs for Each Resume (Optimized) ===" << endl;
+                
+                // Submenu for selecting number of matches to display
+                int displayOption;
+                cout << "\nSelect number of top matches to display:\n";
+                cout << "1. Top 10 matches\n";
+                cout << "2. Top 50 matches\n";
+                cout << "3. Top 100 matches\n";
+                cout << "4. All matches\n";
+                cout << "Enter your choice (1-4): ";
+                cin >> displayOption;
+                
+                if (cin.fail() || displayOption < 1 || displayOption > 4) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid choice. Defaulting to Top 10 matches.\n";
+                    displayOption = 1;
+                }
+                
+                int maxResumesToShow;
+                switch(displayOption) {
+                    case 1: maxResumesToShow = 10; break;
+                    case 2: maxResumesToShow = 50; break;
+                    case 3: maxResumesToShow = 100; break;
+                    case 4: maxResumesToShow = resumeStorage.getSize(); break;
+                    default: maxResumesToShow = 10;
+                }
+                
+                maxResumesToShow = min(maxResumesToShow, resumeStorage.getSize());
+                
+                // Thread count for the parallel matcher
+                int numThreads;
+                cout << "Enter number of threads (0 = all " << WorkStealingPool::defaultThreadCount() << " cores): ";
+                cin >> numThreads;
+                
+                if (cin.fail() || numThreads < 0) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid thread count. Using all cores.\n";
+                    numThreads = 0;
+                }
+                
+                ResultSink report;
+                string reportPath;
+                if (!chooseReportSink(report, reportPath)) break;
+                
+                // Reverse direction: candidates come from the job skill index
+                resumeStorage.findBestMatchesForResumes(jobStorage, maxResumesToShow, report, numThreads);
+                finishReport(report, reportPath);
+                break;
+            }
+
+            case 6: {
+                cout << "\n=== Global Assignment (One Resume per Job) ===" << endl;
+                
+                // Submenu for selecting number of assignments to display
+                int displayOption;
+                cout << "\nSelect number of assignments to display:\n";
+                cout << "1. First 10 jobs\n";
+                cout << "2. First 50 jobs\n";
+                cout << "3. First 100 jobs\n";
+                cout << "4. All jobs\n";
+                cout << "Enter your choice (1-4): ";
+                cin >> displayOption;
+                
+                if (cin.fail() || displayOption < 1 || displayOption > 4) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid choice. Defaulting to first 10 jobs.\n";
+                    displayOption = 1;
+                }
+                
+                int maxJobsToShow;
+                switch(displayOption) {
+                    case 1: maxJobsToShow = 10; break;
+                    case 2: maxJobsToShow = 50; break;
+                    case 3: maxJobsToShow = 100; break;
+                    case 4: maxJobsToShow = jobStorage.getSize(); break;
+                    default: maxJobsToShow = 10;
+                }
+                
+                // How many jobs one resume may take
+                int resumeCapacity;
+                cout << "Enter maximum jobs per resume (1 = one-to-one, up to " << MAX_RESUME_CAPACITY << "): ";
+                cin >> resumeCapacity;
+                
+                if (cin.fail() || resumeCapacity < 1 || resumeCapacity > MAX_RESUME_CAPACITY) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid capacity. Using 1 job per resume.\n";
+                    resumeCapacity = 1;
+                }
+                
+                // Thread count for building the candidate graph
+                int numThreads;
+                cout << "Enter number of threads (0 = all " << WorkStealingPool::defaultThreadCount() << " cores): ";
+                cin >> numThreads;
+                
+                if (cin.fail() || numThreads < 0) {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid thread count. Using all cores.\n";
+                    numThreads = 0;
+                }
+                
+                ResultSink report;
+                string reportPath;
+                if (!chooseReportSink(report, reportPath)) break;
+                
+                jobStorage.assignResumes(resumeStorage, maxJobsToShow, report, resumeCapacity, numThreads);
+                finishReport(report, reportPath);
+                break;
+            }
+
+            case 7: {
                 cout << "\n=== Data Cleaning ===" << endl;
                 cout << "This will regenerate the cleaned CSV files from the original data." << endl;
                 cout << "Continue? (y/n): ";
@@ -254,7 +502,7 @@ int main() {
                 break;
             }
 
-            case 6:
+            case 8:
                 cout << "\nExiting program...\n";
                 break;
 
@@ -262,7 +510,7 @@ int main() {
                 cout << "Invalid choice. Please enter a valid option.\n";
         }
 
-    } while (choice != 6);
+    } while (choice != 8);
 
     return 0;
 }
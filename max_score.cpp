@@ -0,0 +1,117 @@
+#ifndef MAX_SCORE_CPP
+#define MAX_SCORE_CPP
+
+#include <vector>
+#include <algorithm>
+#include <climits>
+#include "posting_index.cpp"
+#include "top_k.cpp"
+using namespace std;
+
+// One clause of a top-K query: the documents it can add score to, and the most it can add
+struct ScoredClause {
+    DocIdList docs;     // sorted
+    int maxScore;       // upper bound of this clause's contribution to any document
+};
+
+// Work done by one pruned query
+struct PruningStats {
+    long long postingsVisited;  // postings stepped over or sought to
+    long long documentsScored;  // documents that needed a full score
+};
+
+// Cursor over one clause's postings with galloping seek
+class ClauseCursor {
+private:
+    const DocIdList* docs;
+    size_t pos;
+
+public:
+    int maxScore;
+
+    ClauseCursor(const ScoredClause& clause) : docs(&clause.docs), pos(0), maxScore(clause.maxScore) {}
+
+    int doc() const { return pos < docs->size() ? (*docs)[pos] : INT_MAX; }
+    void next() { pos++; }
+
+    // Move to the first posting >= target; returns how many postings were skipped
+    size_t seek(int target) {
+        size_t start = pos;
+        size_t n = docs->size();
+        size_t step = 1;
+        size_t high = pos;
+        while (high < n && (*docs)[high] < target) {
+            pos = high + 1;
+            high += step;
+            step *= 2;
+        }
+        pos = lower_bound(docs->begin() + pos, docs->begin() + min(high, n), target) - docs->begin();
+        return pos - start;
+    }
+};
+
+// Document-at-a-time MaxScore evaluation.
+// Clauses are ordered by upper bound; once the top-K threshold exceeds the summed bounds of
+// the weakest clauses, those become "non-essential": documents that only they contain cannot
+// enter the top K, so only the essential clauses drive the traversal and the others are merely
+// probed (seek) for the documents that remain. A document is fully scored with
+// exactScore(docId) only if its summed clause bounds can still beat the current K-th result.
+// Requirements: every document that can score above zero is in some clause, and exactScore
+// never exceeds the summed maxScore of the clauses containing the document.
+template<typename ScoreFunction>
+PruningStats maxScoreTopK(vector<ScoredClause>& clauses, ScoreFunction exactScore, TopKCollector& top) {
+    PruningStats stats = {0, 0};
+    if (top.capacity() == 0) return stats;
+
+    sort(clauses.begin(), clauses.end(), [](const ScoredClause& a, const ScoredClause& b) { return a.maxScore < b.maxScore; });
+    vector<ClauseCursor> cursors(clauses.begin(), clauses.end());
+    int n = (int)cursors.size();
+    vector<long long> boundUpTo(n); // summed maxScore of clauses [0, i]
+    long long running = 0;
+    for (int i = 0; i < n; i++) {
+        running += cursors[i].maxScore;
+        boundUpTo[i] = running;
+    }
+
+    int firstEssential = 0;
+    while (true) {
+        // Clauses whose combined bound is below the threshold cannot place a document on their own
+        while (firstEssential < n && top.full() && boundUpTo[firstEssential] < top.threshold()) firstEssential++;
+        if (firstEssential == n) break;
+
+        int docId = INT_MAX;
+        for (int i = firstEssential; i < n; i++) docId = min(docId, cursors[i].doc());
+        if (docId == INT_MAX) break;
+
+        long long bound = 0;
+        for (int i = firstEssential; i < n; i++) {
+            if (cursors[i].doc() == docId) bound += cursors[i].maxScore;
+        }
+        // Probe the non-essential clauses, strongest first, while the document can still get in
+        bool possible = true;
+        for (int i = firstEssential - 1; i >= 0; i--) {
+            if (!top.canEnter(docId, bound + boundUpTo[i])) {
+                possible = false;
+                break;
+            }
+            stats.postingsVisited += cursors[i].seek(docId);
+            if (cursors[i].doc() == docId) bound += cursors[i].maxScore;
+        }
+
+        if (possible && top.canEnter(docId, bound)) {
+            int score = exactScore(docId);
+            stats.documentsScored++;
+            if (score > 0) top.offer(docId, score);
+        }
+
+        for (int i = firstEssential; i < n; i++) {
+            if (cursors[i].doc() == docId) {
+                cursors[i].next();
+                stats.postingsVisited++;
+            }
+        }
+    }
+    return stats;
+}
+
+#endif
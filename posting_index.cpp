@@ -0,0 +1,247 @@
+#ifndef POSTING_INDEX_CPP
+#define POSTING_INDEX_CPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include "snapshot.cpp"
+#include "arena.cpp"
+using namespace std;
+
+// Sorted list of document IDs returned by index searches
+typedef vector<int> DocIdList;
+
+// Non-owning view of one delta-encoded posting list.
+// The first entry is the absolute document ID, every following entry is the gap to the previous ID.
+class PostingSpan {
+private:
+    const uint32_t* deltas;
+    uint32_t count;
+
+public:
+    class const_iterator {
+    private:
+        const uint32_t* ptr;
+        const uint32_t* end;
+        uint32_t value;
+
+    public:
+        const_iterator(const uint32_t* p, const uint32_t* e) : ptr(p), end(e), value(p != e ? *p : 0) {}
+
+        int operator*() const { return (int)value; }
+        const_iterator& operator++() {
+            ++ptr;
+            if (ptr != end) value += *ptr;
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const { return ptr == other.ptr; }
+        bool operator!=(const const_iterator& other) const { return ptr != other.ptr; }
+    };
+
+    PostingSpan() : deltas(nullptr), count(0) {}
+    PostingSpan(const uint32_t* data, uint32_t n) : deltas(data), count(n) {}
+
+    uint32_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const_iterator begin() const { return const_iterator(deltas, deltas + count); }
+    const_iterator end() const { return const_iterator(deltas + count, deltas + count); }
+
+    // Decode (prefix-sum) the gaps into absolute document IDs
+    void decodeTo(int* out) const {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            value += deltas[i];
+            out[i] = (int)value;
+        }
+    }
+
+    DocIdList decode() const {
+        DocIdList ids(count);
+        decodeTo(ids.data());
+        return ids;
+    }
+};
+
+// Immutable inverted index in a compact, flat layout:
+//   - a sorted term table (all term text in one char array, plus offsets)
+//   - one contiguous array of delta-encoded uint32 postings, sliced per term
+// Lookups binary-search the term table and return a PostingSpan into the posting array.
+class PostingIndex {
+private:
+    vector<char> termChars;          // concatenated term text, sorted by term
+    vector<uint32_t> termOffsets;    // term i = termChars[termOffsets[i] .. termOffsets[i + 1])
+    vector<uint64_t> postingOffsets; // postings of term i = deltas[postingOffsets[i] .. postingOffsets[i + 1])
+    vector<uint32_t> deltas;         // delta-encoded document IDs
+
+    friend class PostingIndexBuilder;
+
+    int compareTerm(int termId, const char* key, size_t keyLength) const {
+        size_t length = termOffsets[termId + 1] - termOffsets[termId];
+        int cmp = memcmp(termChars.data() + termOffsets[termId], key, min(length, keyLength));
+        if (cmp != 0) return cmp;
+        return length < keyLength ? -1 : (length > keyLength ? 1 : 0);
+    }
+
+public:
+    PostingIndex() : termOffsets(1, 0), postingOffsets(1, 0) {}
+
+    int getTermCount() const { return (int)termOffsets.size() - 1; }
+    size_t getPostingCount() const { return deltas.size(); }
+
+    string_view getTerm(int termId) const {
+        return string_view(termChars.data() + termOffsets[termId], termOffsets[termId + 1] - termOffsets[termId]);
+    }
+
+    PostingSpan getPostings(int termId) const {
+        return PostingSpan(deltas.data() + postingOffsets[termId],
+                           (uint32_t)(postingOffsets[termId + 1] - postingOffsets[termId]));
+    }
+
+    // Term ID of an exact term, or -1
+    int findTerm(string_view term) const {
+        int low = 0, high = getTermCount() - 1;
+        while (low <= high) {
+            int mid = low + (high - low) / 2;
+            int cmp = compareTerm(mid, term.data(), term.size());
+            if (cmp == 0) return mid;
+            if (cmp < 0) low = mid + 1;
+            else high = mid - 1;
+        }
+        return -1;
+    }
+
+    // Postings of an exact term (empty span if the term is not indexed)
+    PostingSpan lookup(string_view term) const {
+        int termId = findTerm(term);
+        return termId < 0 ? PostingSpan() : getPostings(termId);
+    }
+
+    // Snapshot support: the four flat arrays are stored as-is
+    void writeTo(SnapshotWriter& out) const {
+        out.putArray(termChars);
+        out.putArray(termOffsets);
+        out.putArray(postingOffsets);
+        out.putArray(deltas);
+    }
+
+    bool readFrom(SnapshotReader& in) {
+        in.getArray(termChars);
+        in.getArray(termOffsets);
+        in.getArray(postingOffsets);
+        in.getArray(deltas);
+        // Offsets must describe the arrays they slice
+        bool consistent = in.ok() && !termOffsets.empty() && termOffsets.size() == postingOffsets.size() &&
+                          termOffsets.back() == termChars.size() && postingOffsets.back() == deltas.size();
+        if (!consistent) *this = PostingIndex();
+        return consistent;
+    }
+
+    // Approximate heap footprint in bytes
+    size_t memoryBytes() const {
+        return termChars.capacity() * sizeof(char) + termOffsets.capacity() * sizeof(uint32_t) +
+               postingOffsets.capacity() * sizeof(uint64_t) + deltas.capacity() * sizeof(uint32_t);
+    }
+};
+
+// Collects (term, document) pairs and packs them into a PostingIndex. Distinct terms are
+// copied once into an arena and found through an open-addressing table, so adding a posting
+// allocates nothing beyond the growth of the pair arrays.
+class PostingIndexBuilder {
+private:
+    Arena termText;
+    vector<string_view> terms;  // term ID -> text (in termText)
+    vector<int32_t> slots;      // open-addressing table of term IDs, -1 = empty
+    vector<uint32_t> pairTerms; // term ID of every added posting
+    vector<uint32_t> pairDocs;  // document ID of every added posting
+
+    static uint64_t hashTerm(string_view term) {
+        uint64_t h = 14695981039346656037ULL;
+        for (unsigned char c : term) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    void insertSlot(uint32_t termId) {
+        size_t mask = slots.size() - 1;
+        size_t slot = hashTerm(terms[termId]) & mask;
+        while (slots[slot] >= 0) slot = (slot + 1) & mask;
+        slots[slot] = (int32_t)termId;
+    }
+
+public:
+    PostingIndexBuilder() : slots(1024, -1) {}
+
+    void add(string_view term, int docId) {
+        size_t mask = slots.size() - 1;
+        size_t slot = hashTerm(term) & mask;
+        while (slots[slot] >= 0 && terms[slots[slot]] != term) slot = (slot + 1) & mask;
+        uint32_t termId;
+        if (slots[slot] >= 0) {
+            termId = (uint32_t)slots[slot];
+        } else {
+            termId = (uint32_t)terms.size();
+            terms.push_back(termText.copy(term));
+            if (terms.size() * 2 > slots.size()) {
+                slots.assign(slots.size() * 2, -1);
+                for (uint32_t t = 0; t < terms.size(); t++) insertSlot(t);
+            } else {
+                slots[slot] = (int32_t)termId;
+            }
+        }
+        pairTerms.push_back(termId);
+        pairDocs.push_back((uint32_t)docId);
+    }
+
+    PostingIndex build() const {
+        PostingIndex index;
+        size_t numTerms = terms.size();
+
+        // Sort the term table
+        vector<uint32_t> order(numTerms);
+        for (size_t i = 0; i < numTerms; i++) order[i] = (uint32_t)i;
+        sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return terms[a] < terms[b]; });
+        vector<uint32_t> rank(numTerms);
+        for (size_t i = 0; i < numTerms; i++) rank[order[i]] = (uint32_t)i;
+
+        // Bucket postings by sorted term (counting sort keeps insertion order within a term)
+        vector<uint64_t> bucketStart(numTerms + 1, 0);
+        for (uint32_t termId : pairTerms) bucketStart[rank[termId] + 1]++;
+        for (size_t i = 0; i < numTerms; i++) bucketStart[i + 1] += bucketStart[i];
+        vector<uint32_t> docs(pairDocs.size());
+        vector<uint64_t> fill(bucketStart.begin(), bucketStart.end() - 1);
+        for (size_t i = 0; i < pairDocs.size(); i++) {
+            docs[fill[rank[pairTerms[i]]]++] = pairDocs[i];
+        }
+
+        // Write terms and delta-encoded, de-duplicated postings
+        index.termOffsets.reserve(numTerms + 1);
+        index.postingOffsets.reserve(numTerms + 1);
+        index.deltas.reserve(docs.size());
+        for (size_t t = 0; t < numTerms; t++) {
+            string_view term = terms[order[t]];
+            index.termChars.insert(index.termChars.end(), term.begin(), term.end());
+            index.termOffsets.push_back((uint32_t)index.termChars.size());
+
+            uint32_t* first = docs.data() + bucketStart[t];
+            uint32_t* last = docs.data() + bucketStart[t + 1];
+            if (!is_sorted(first, last)) sort(first, last);
+            uint32_t previous = 0;
+            for (uint32_t* p = first; p != last; p++) {
+                if (p != first && *p == previous) continue; // same term twice in one document
+                index.deltas.push_back(*p - previous);
+                previous = *p;
+            }
+            index.postingOffsets.push_back(index.deltas.size());
+        }
+        index.termChars.shrink_to_fit();
+        return index;
+    }
+};
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef RECORD_STORE_CPP
+#define RECORD_STORE_CPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "skills.cpp"
+#include "scoring.cpp"
+#include "snapshot.cpp"
+using namespace std;
+
+// Location of a string in a StringArena
+struct StringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Append-only character storage. Strings are addressed by offset, so growing the buffer
+// never invalidates a StringRef; views are only valid until the next add().
+class StringArena {
+private:
+    vector<char> bytes;
+
+public:
+    StringRef add(string_view text) {
+        StringRef ref = {(uint32_t)bytes.size(), (uint32_t)text.size()};
+        bytes.insert(bytes.end(), text.begin(), text.end());
+        return ref;
+    }
+
+    string_view view(StringRef ref) const { return string_view(bytes.data() + ref.offset, ref.length); }
+
+    bool contains(StringRef ref) const { return (uint64_t)ref.offset + ref.length <= bytes.size(); }
+    size_t size() const { return bytes.size(); }
+    void reserve(size_t length) { bytes.reserve(length); }
+    void clear() { bytes.clear(); }
+
+    // Append every string of other; its refs stay valid when shifted by the returned offset
+    uint32_t append(const StringArena& other) {
+        uint32_t shift = (uint32_t)bytes.size();
+        bytes.insert(bytes.end(), other.bytes.begin(), other.bytes.end());
+        return shift;
+    }
+
+    const vector<char>& getBytes() const { return bytes; }
+    void setBytes(vector<char> data) { bytes = move(data); }
+};
+
+// Columnar storage of the records of one collection. Row r is the record with document ID r:
+//   ids           - Job_ID / Resume_ID
+//   titleIds      - interned titles (jobs share a few hundred distinct titles; resumes use "")
+//   skillTexts    - the cleaned skill list, in the text arena
+//   customTexts   - free text that is not the standard synthesized one (empty for almost every record)
+//   skills        - packed skill bitmaps, handed to the scoring engine as they are
+// The filler fields of the old record objects ("Company Not Specified", ...) were constants
+// and are not stored. Replaced or removed text stays in the arena until the store is cleared.
+class RecordStore {
+private:
+    vector<int32_t> ids;
+    vector<uint32_t> titleIds;
+    vector<StringRef> skillTexts;
+    vector<StringRef> customTexts;
+    SkillMatrix skills;
+    StringArena text;
+
+    // Title interning: open-addressing table of title IDs (-1 = empty), hashed on the text
+    vector<StringRef> titles;
+    vector<int32_t> titleSlots;
+
+    static uint64_t hashText(string_view value) {
+        uint64_t h = 14695981039346656037ULL;
+        for (unsigned char c : value) {
+            h ^= c;
+            h *= 1099511628211ULL;
+        }
+        return h;
+    }
+
+    void insertTitleSlot(uint32_t titleId) {
+        size_t mask = titleSlots.size() - 1;
+        size_t slot = hashText(text.view(titles[titleId])) & mask;
+        while (titleSlots[slot] >= 0) slot = (slot + 1) & mask;
+        titleSlots[slot] = (int32_t)titleId;
+    }
+
+    void rehashTitles(size_t slotCount) {
+        titleSlots.assign(slotCount, -1);
+        for (uint32_t t = 0; t < titles.size(); t++) insertTitleSlot(t);
+    }
+
+    uint32_t internTitle(string_view title) {
+        size_t mask = titleSlots.size() - 1;
+        for (size_t slot = hashText(title) & mask; titleSlots[slot] >= 0; slot = (slot + 1) & mask) {
+            if (text.view(titles[titleSlots[slot]]) == title) return (uint32_t)titleSlots[slot];
+        }
+        titles.push_back(text.add(title));
+        if (titles.size() * 2 > titleSlots.size()) rehashTitles(titleSlots.size() * 2);
+        else insertTitleSlot((uint32_t)titles.size() - 1);
+        return (uint32_t)titles.size() - 1;
+    }
+
+public:
+    RecordStore() { clear(); }
+
+    int size() const { return (int)ids.size(); }
+
+    // Room for rows records and textBytes more bytes of text, so appending them never regrows
+    void reserve(int rows, size_t textBytes = 0) {
+        text.reserve(text.size() + textBytes);
+        ids.reserve(rows);
+        titleIds.reserve(rows);
+        skillTexts.reserve(rows);
+        customTexts.reserve(rows);
+        skills.reserve(rows);
+    }
+
+    void clear() {
+        ids.clear();
+        titleIds.clear();
+        skillTexts.clear();
+        customTexts.clear();
+        skills.clear();
+        text.clear();
+        titles.clear();
+        titleSlots.assign(64, -1);
+        internTitle(""); // title 0
+    }
+
+    // Append an empty row; returns its index
+    int addRow() {
+        ids.push_back(-1);
+        titleIds.push_back(0);
+        skillTexts.push_back(StringRef{0, 0});
+        customTexts.push_back(StringRef{0, 0});
+        skills.addRow(SkillSet());
+        return size() - 1;
+    }
+
+    // Overwrite row r (customText empty = the record uses its synthesized text)
+    void setRow(int r, int id, string_view title, string_view skillText, string_view customText, const SkillSet& skillBits) {
+        ids[r] = id;
+        titleIds[r] = internTitle(title);
+        skillTexts[r] = text.add(skillText);
+        customTexts[r] = customText.empty() ? StringRef{0, 0} : text.add(customText);
+        skills.setRow(r, skillBits);
+    }
+
+    // Reset row r to an empty record (removed records never match)
+    void clearRow(int r) {
+        ids[r] = -1;
+        titleIds[r] = 0;
+        skillTexts[r] = StringRef{0, 0};
+        customTexts[r] = StringRef{0, 0};
+        skills.setRow(r, SkillSet());
+    }
+
+    int id(int r) const { return ids[r]; }
+    string_view title(int r) const { return text.view(titles[titleIds[r]]); }
+    string_view skillText(int r) const { return text.view(skillTexts[r]); }
+    string_view customText(int r) const { return text.view(customTexts[r]); }
+    SkillSet skillSet(int r) const { return skills.getRow(r); }
+    const SkillMatrix& skillMatrix() const { return skills; }
+
+    // Append the rows of other (e.g. a chunk parsed on another thread). Its text arena is copied
+    // in one block and its titles are re-interned.
+    void append(const RecordStore& other) {
+        int first = size();
+        int rows = other.size();
+        reserve(first + rows, other.text.size());
+        uint32_t shift = text.append(other.text);
+        vector<uint32_t> titleMap(other.titles.size());
+        for (size_t t = 0; t < other.titles.size(); t++) titleMap[t] = internTitle(other.text.view(other.titles[t]));
+        auto shifted = [shift](StringRef ref) { return ref.length == 0 ? ref : StringRef{ref.offset + shift, ref.length}; };
+        for (int r = 0; r < rows; r++) {
+            addRow();
+            ids[first + r] = other.ids[r];
+            titleIds[first + r] = titleMap[other.titleIds[r]];
+            skillTexts[first + r] = shifted(other.skillTexts[r]);
+            customTexts[first + r] = shifted(other.customTexts[r]);
+            skills.setRow(first + r, other.skills.getRow(r));
+        }
+    }
+
+    int distinctTitles() const { return (int)titles.size(); }
+
+    // Bytes held by the columns, the text arena and the title table
+    size_t memoryBytes() const {
+        return ids.capacity() * sizeof(int32_t) + titleIds.capacity() * sizeof(uint32_t)
+             + (skillTexts.capacity() + customTexts.capacity() + titles.capacity()) * sizeof(StringRef)
+             + skills.getWords().capacity() * sizeof(uint64_t) + text.getBytes().capacity()
+             + titleSlots.capacity() * sizeof(int32_t);
+    }
+
+    // Snapshot section: every column as one array, then the text arena
+    void writeTo(SnapshotWriter& out) const {
+        out.putArray(ids);
+        out.putArray(titleIds);
+        out.putArray(skillTexts);
+        out.putArray(customTexts);
+        out.putArray(skills.getWords());
+        out.putArray(titles);
+        out.putArray(text.getBytes());
+    }
+
+    // Replaces the contents; false (and empty) if the section is inconsistent
+    bool readFrom(SnapshotReader& in) {
+        vector<uint64_t> skillWords;
+        vector<char> bytes;
+        bool read = in.getArray(ids) && in.getArray(titleIds) && in.getArray(skillTexts) && in.getArray(customTexts)
+                 && in.getArray(skillWords) && in.getArray(titles) && in.getArray(bytes) && skills.setWords(move(skillWords));
+        text.setBytes(move(bytes));
+        size_t rows = ids.size();
+        bool valid = read && titleIds.size() == rows && skillTexts.size() == rows && customTexts.size() == rows
+                  && skills.getRows() == (int)rows && !titles.empty() && titles[0].length == 0;
+        for (size_t r = 0; valid && r < rows; r++) {
+            valid = titleIds[r] < titles.size() && text.contains(skillTexts[r]) && text.contains(customTexts[r]);
+        }
+        for (size_t t = 0; valid && t < titles.size(); t++) valid = text.contains(titles[t]);
+        if (!valid) {
+            clear();
+            return false;
+        }
+        size_t slotCount = 64;
+        while (slotCount < titles.size() * 2) slotCount *= 2;
+        rehashTitles(slotCount);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef RESULT_SINK_CPP
+#define RESULT_SINK_CPP
+
+#include <string>
+#include <string_view>
+#include "result_writer.cpp"
+using namespace std;
+
+// Destination of the human-readable reports of searches and matchers, so they never write to
+// cout themselves. Reports hand over whole formatted blocks (built per thread where the work is
+// parallel), which go out through a large-buffer BufferedWriter - no flush per line.
+// A quiet sink drops the per-result blocks and keeps only headers and summaries.
+class ResultSink {
+private:
+    BufferedWriter out;
+    bool quiet;
+
+public:
+    ResultSink() : quiet(false) {}
+
+    // "-" or "" = stdout
+    bool open(const string& path, bool quietMode = false) {
+        quiet = quietMode;
+        return out.open(path);
+    }
+
+    bool isQuiet() const { return quiet; }
+    bool ok() const { return out.ok(); }
+
+    // One or more per-result blocks (dropped when quiet)
+    void result(string_view text) {
+        if (!quiet) out.write(text.data(), text.size());
+    }
+
+    // Headers, "nothing found" notes and summaries (always written)
+    void summary(string_view text) { out.write(text.data(), text.size()); }
+
+    // Hand everything written so far to the OS; reports call this when they are done, so
+    // console output stays in order with the menu's own cout prompts
+    bool flush() { return out.flush(); }
+
+    bool close() { return out.close(); }
+};
+
+#endif
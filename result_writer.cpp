@@ -0,0 +1,258 @@
+#ifndef RESULT_WRITER_CPP
+#define RESULT_WRITER_CPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+using namespace std;
+
+// Output to stdout or a file through one large buffer: text is appended in memory and written
+// in big blocks, so producing many small records costs few system calls and no per-line flushes
+class BufferedWriter {
+private:
+    static constexpr size_t FLUSH_BYTES = 1 << 20;
+
+    FILE* file;
+    bool ownsFile;
+    bool failed;
+    string buffer;
+
+public:
+    BufferedWriter() : file(nullptr), ownsFile(false), failed(false) {
+        buffer.reserve(FLUSH_BYTES + 4096);
+    }
+    ~BufferedWriter() { close(); }
+
+    BufferedWriter(const BufferedWriter&) = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    // "-" or "" = stdout
+    bool open(const string& path) {
+        close();
+        failed = false;
+        if (path.empty() || path == "-") {
+            file = stdout;
+            ownsFile = false;
+        } else {
+            file = fopen(path.c_str(), "wb");
+            ownsFile = true;
+        }
+        return file != nullptr;
+    }
+
+    bool ok() const { return file != nullptr && !failed; }
+
+    void write(const char* data, size_t length) {
+        buffer.append(data, length);
+        if (buffer.size() >= FLUSH_BYTES) flush();
+    }
+    void write(const string& text) { write(text.data(), text.size()); }
+    void put(char c) {
+        buffer += c;
+        if (buffer.size() >= FLUSH_BYTES) flush();
+    }
+
+    void writeInt(long long value) {
+        char digits[24];
+        int length = snprintf(digits, sizeof(digits), "%lld", value);
+        write(digits, length);
+    }
+
+    // Native-byte-order value (binary formats)
+    template<typename V>
+    void writeValue(const V& value) {
+        static_assert(is_trivially_copyable<V>::value, "binary values must be trivially copyable");
+        write((const char*)&value, sizeof(V));
+    }
+
+    bool flush() {
+        if (file == nullptr) return false;
+        if (!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) failed = true;
+        buffer.clear();
+        if (fflush(file) != 0) failed = true;
+        return !failed;
+    }
+
+    bool close() {
+        if (file == nullptr) return true;
+        bool flushed = flush();
+        if (ownsFile && fclose(file) != 0) flushed = false;
+        file = nullptr;
+        return flushed;
+    }
+};
+
+// Kind of query a result row answers
+enum QueryKind { QUERY_JOB_TITLE, QUERY_JOB_SKILLS, QUERY_RESUME_SKILLS, QUERY_JOB_MATCH };
+
+inline const char* queryKindName(QueryKind kind) {
+    switch (kind) {
+        case QUERY_JOB_TITLE: return "title";
+        case QUERY_JOB_SKILLS: return "skills";
+        case QUERY_RESUME_SKILLS: return "resume-skills";
+        case QUERY_JOB_MATCH: return "match";
+    }
+    return "unknown";
+}
+
+// One result of a batch query: the record with the given ID ranked rank-th (from 1) with score
+// points. Match queries are one job (query = its ID) and rank its best resumes.
+struct ResultRow {
+    int queryId;
+    QueryKind kind;
+    const string* query;
+    int rank;
+    int id;
+    int score;
+};
+
+// Machine-readable result formats. beginQuery() is called once before the rows of each query
+// (also for queries without results); finish() after the last row.
+class ResultWriter {
+protected:
+    BufferedWriter& out;
+
+public:
+    explicit ResultWriter(BufferedWriter& output) : out(output) {}
+    virtual ~ResultWriter() = default;
+
+    virtual void beginQuery(int /*queryId*/, QueryKind /*kind*/, const string& /*query*/) {}
+    virtual void writeRow(const ResultRow& row) = 0;
+    virtual void finish() {}
+};
+
+// query_id,type,query,rank,id,score - RFC 4180 quoting for the query text
+class CsvResultWriter : public ResultWriter {
+public:
+    explicit CsvResultWriter(BufferedWriter& output) : ResultWriter(output) {
+        out.write("query_id,type,query,rank,id,score\n");
+    }
+
+    void writeRow(const ResultRow& row) override {
+        out.writeInt(row.queryId);
+        out.put(',');
+        out.write(queryKindName(row.kind), strlen(queryKindName(row.kind)));
+        out.put(',');
+        const string& query = *row.query;
+        if (query.find_first_of(",\"\r\n") != string::npos) {
+            out.put('"');
+            for (char c : query) {
+                if (c == '"') out.put('"');
+                out.put(c);
+            }
+            out.put('"');
+        } else {
+            out.write(query);
+        }
+        out.put(',');
+        out.writeInt(row.rank);
+        out.put(',');
+        out.writeInt(row.id);
+        out.put(',');
+        out.writeInt(row.score);
+        out.put('\n');
+    }
+};
+
+// One JSON object per line: {"query_id":..,"type":..,"query":..,"rank":..,"id":..,"score":..}
+class JsonLinesResultWriter : public ResultWriter {
+private:
+    void writeJsonString(const string& text) {
+        out.put('"');
+        for (unsigned char c : text) {
+            switch (c) {
+                case '"': out.write("\\\"", 2); break;
+                case '\\': out.write("\\\\", 2); break;
+                case '\n': out.write("\\n", 2); break;
+                case '\r': out.write("\\r", 2); break;
+                case '\t': out.write("\\t", 2); break;
+                default:
+                    if (c < 0x20) {
+                        char escaped[8];
+                        snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                        out.write(escaped, 6);
+                    } else {
+                        out.put((char)c);
+                    }
+            }
+        }
+        out.put('"');
+    }
+
+public:
+    explicit JsonLinesResultWriter(BufferedWriter& output) : ResultWriter(output) {}
+
+    void writeRow(const ResultRow& row) override {
+        out.write("{\"query_id\":", 12);
+        out.writeInt(row.queryId);
+        out.write(",\"type\":", 8);
+        writeJsonString(queryKindName(row.kind));
+        out.write(",\"query\":", 9);
+        writeJsonString(*row.query);
+        out.write(",\"rank\":", 8);
+        out.writeInt(row.rank);
+        out.write(",\"id\":", 6);
+        out.writeInt(row.id);
+        out.write(",\"score\":", 9);
+        out.writeInt(row.score);
+        out.write("}\n", 2);
+    }
+};
+
+// Compact binary results (native byte order):
+//   "JMRESULT" uint32 version
+//   per query:  'Q' uint32 queryId, uint8 type, uint32 length, query bytes
+//   per row:    'R' uint32 queryId, uint32 rank, int32 id, int32 score
+//   end:        'E' uint32 queryCount, uint64 rowCount
+const char RESULT_BINARY_MAGIC[8] = {'J', 'M', 'R', 'E', 'S', 'U', 'L', 'T'};
+const uint32_t RESULT_BINARY_VERSION = 1;
+
+class BinaryResultWriter : public ResultWriter {
+private:
+    uint32_t queries;
+    uint64_t rows;
+
+public:
+    explicit BinaryResultWriter(BufferedWriter& output) : ResultWriter(output), queries(0), rows(0) {
+        out.write(RESULT_BINARY_MAGIC, sizeof(RESULT_BINARY_MAGIC));
+        out.writeValue<uint32_t>(RESULT_BINARY_VERSION);
+    }
+
+    void beginQuery(int queryId, QueryKind kind, const string& query) override {
+        out.put('Q');
+        out.writeValue<uint32_t>(queryId);
+        out.writeValue<uint8_t>(kind);
+        out.writeValue<uint32_t>((uint32_t)query.size());
+        out.write(query);
+        queries++;
+    }
+
+    void writeRow(const ResultRow& row) override {
+        out.put('R');
+        out.writeValue<uint32_t>(row.queryId);
+        out.writeValue<uint32_t>(row.rank);
+        out.writeValue<int32_t>(row.id);
+        out.writeValue<int32_t>(row.score);
+        rows++;
+    }
+
+    void finish() override {
+        out.put('E');
+        out.writeValue<uint32_t>(queries);
+        out.writeValue<uint64_t>(rows);
+    }
+};
+
+// "csv", "jsonl" or "binary"; nullptr for an unknown format
+inline unique_ptr<ResultWriter> createResultWriter(const string& format, BufferedWriter& output) {
+    if (format == "csv") return unique_ptr<ResultWriter>(new CsvResultWriter(output));
+    if (format == "jsonl") return unique_ptr<ResultWriter>(new JsonLinesResultWriter(output));
+    if (format == "binary") return unique_ptr<ResultWriter>(new BinaryResultWriter(output));
+    return nullptr;
+}
+
+#endif
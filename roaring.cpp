@@ -0,0 +1,365 @@
+#ifndef ROARING_CPP
+#define ROARING_CPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include "skills.cpp"
+#include "posting_index.cpp"
+using namespace std;
+
+// Roaring-style compressed bitmap of document IDs.
+// IDs are split into a 16-bit key (high bits) and a 16-bit value (low bits).
+// Each key owns one container, whose representation adapts to its density:
+//   ARRAY  - sorted uint16 values, used up to 4096 entries (sparse)
+//   BITMAP - 1024 x 64-bit words, used above 4096 entries (dense)
+//   RUN    - (start, length - 1) pairs, chosen by runOptimize() when it is smallest
+const int ROARING_ARRAY_LIMIT = 4096;
+const int ROARING_BITMAP_WORDS = 1024;
+
+class RoaringContainer {
+public:
+    enum Type { ARRAY, BITMAP, RUN };
+
+    Type type;
+    int cardinality;
+    vector<uint16_t> values; // ARRAY: sorted values; RUN: start/length-1 pairs
+    vector<uint64_t> bits;   // BITMAP: ROARING_BITMAP_WORDS words
+
+    RoaringContainer() : type(ARRAY), cardinality(0) {}
+
+    bool contains(uint16_t value) const {
+        if (type == ARRAY) {
+            return binary_search(values.begin(), values.end(), value);
+        }
+        if (type == BITMAP) {
+            return (bits[value >> 6] >> (value & 63)) & 1;
+        }
+        // RUN: find the last run starting at or before value
+        int low = 0, high = (int)values.size() / 2 - 1, found = -1;
+        while (low <= high) {
+            int mid = (low + high) / 2;
+            if (values[2 * mid] <= value) { found = mid; low = mid + 1; }
+            else high = mid - 1;
+        }
+        return found >= 0 && value <= values[2 * found] + values[2 * found + 1];
+    }
+
+    // Expand into a full 1024-word bitmap
+    void toWords(uint64_t* words) const {
+        if (type == BITMAP) {
+            memcpy(words, bits.data(), ROARING_BITMAP_WORDS * sizeof(uint64_t));
+            return;
+        }
+        memset(words, 0, ROARING_BITMAP_WORDS * sizeof(uint64_t));
+        if (type == ARRAY) {
+            for (uint16_t v : values) words[v >> 6] |= (uint64_t)1 << (v & 63);
+        } else {
+            for (size_t r = 0; r + 1 < values.size(); r += 2) {
+                for (uint32_t v = values[r]; v <= (uint32_t)values[r] + values[r + 1]; v++) {
+                    words[v >> 6] |= (uint64_t)1 << (v & 63);
+                }
+            }
+        }
+    }
+
+    // Build from a 1024-word bitmap, picking ARRAY or BITMAP by cardinality
+    static RoaringContainer fromWords(const uint64_t* words) {
+        RoaringContainer c;
+        int card = 0;
+        for (int w = 0; w < ROARING_BITMAP_WORDS; w++) card += popcount64(words[w]);
+        c.cardinality = card;
+        if (card > ROARING_ARRAY_LIMIT) {
+            c.type = BITMAP;
+            c.bits.assign(words, words + ROARING_BITMAP_WORDS);
+        } else {
+            c.type = ARRAY;
+            c.values.reserve(card);
+            for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                uint64_t word = words[w];
+                while (word) {
+                    c.values.push_back((uint16_t)(w * 64 + countTrailingZeros64(word)));
+                    word &= word - 1;
+                }
+            }
+        }
+        return c;
+    }
+
+    // Build from sorted, duplicate-free values
+    static RoaringContainer fromSortedValues(const vector<uint16_t>& sorted) {
+        if ((int)sorted.size() <= ROARING_ARRAY_LIMIT) {
+            RoaringContainer c;
+            c.values = sorted;
+            c.cardinality = (int)sorted.size();
+            return c;
+        }
+        vector<uint64_t> words(ROARING_BITMAP_WORDS, 0);
+        for (uint16_t v : sorted) words[v >> 6] |= (uint64_t)1 << (v & 63);
+        return fromWords(words.data());
+    }
+
+    // Append every value (plus the key's high bits) to out
+    void appendTo(uint32_t high, DocIdList& out) const {
+        if (type == ARRAY) {
+            for (uint16_t v : values) out.push_back((int)(high | v));
+        } else if (type == BITMAP) {
+            for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+                uint64_t word = bits[w];
+                while (word) {
+                    out.push_back((int)(high | (uint32_t)(w * 64 + countTrailingZeros64(word))));
+                    word &= word - 1;
+                }
+            }
+        } else {
+            for (size_t r = 0; r + 1 < values.size(); r += 2) {
+                for (uint32_t v = values[r]; v <= (uint32_t)values[r] + values[r + 1]; v++) {
+                    out.push_back((int)(high | v));
+                }
+            }
+        }
+    }
+
+    // Switch to a RUN container when that is the smallest representation
+    void runOptimize() {
+        vector<uint64_t> words(ROARING_BITMAP_WORDS);
+        toWords(words.data());
+        vector<uint16_t> runs;
+        int v = 0;
+        while (v < 65536) {
+            if (!((words[v >> 6] >> (v & 63)) & 1)) { v++; continue; }
+            int start = v;
+            while (v < 65536 && ((words[v >> 6] >> (v & 63)) & 1)) v++;
+            runs.push_back((uint16_t)start);
+            runs.push_back((uint16_t)(v - start - 1));
+        }
+        size_t runBytes = runs.size() * sizeof(uint16_t);
+        size_t arrayBytes = cardinality <= ROARING_ARRAY_LIMIT ? cardinality * sizeof(uint16_t) : SIZE_MAX;
+        size_t bitmapBytes = ROARING_BITMAP_WORDS * sizeof(uint64_t);
+        if (runBytes < arrayBytes && runBytes < bitmapBytes) {
+            type = RUN;
+            values.swap(runs);
+            bits.clear();
+            bits.shrink_to_fit();
+        } else if (type == RUN) {
+            *this = fromWords(words.data());
+        }
+    }
+
+    size_t memoryBytes() const {
+        return values.capacity() * sizeof(uint16_t) + bits.capacity() * sizeof(uint64_t);
+    }
+};
+
+class RoaringBitmap {
+private:
+    vector<uint16_t> keys;               // sorted high 16 bits
+    vector<RoaringContainer> containers; // one per key
+
+    enum Operation { OP_AND, OP_ANDNOT };
+    static RoaringContainer combine(const RoaringContainer& a, const RoaringContainer& b, Operation op);
+    static RoaringBitmap apply(const RoaringBitmap& a, const RoaringBitmap& b, Operation op);
+
+public:
+    // Build from sorted, duplicate-free document IDs
+    template<typename Iterator>
+    static RoaringBitmap fromSorted(Iterator first, Iterator last) {
+        RoaringBitmap result;
+        vector<uint16_t> pending;
+        int currentKey = -1;
+        for (Iterator it = first; it != last; ++it) {
+            uint32_t id = (uint32_t)*it;
+            int key = (int)(id >> 16);
+            if (key != currentKey) {
+                if (!pending.empty()) {
+                    result.keys.push_back((uint16_t)currentKey);
+                    result.containers.push_back(RoaringContainer::fromSortedValues(pending));
+                    pending.clear();
+                }
+                currentKey = key;
+            }
+            pending.push_back((uint16_t)(id & 0xffff));
+        }
+        if (!pending.empty()) {
+            result.keys.push_back((uint16_t)currentKey);
+            result.containers.push_back(RoaringContainer::fromSortedValues(pending));
+        }
+        return result;
+    }
+
+    static RoaringBitmap fromPostings(const PostingSpan& postings) {
+        return fromSorted(postings.begin(), postings.end());
+    }
+
+    bool empty() const { return keys.empty(); }
+
+    uint64_t cardinality() const {
+        uint64_t total = 0;
+        for (const RoaringContainer& c : containers) total += c.cardinality;
+        return total;
+    }
+
+    bool contains(uint32_t id) const {
+        auto it = lower_bound(keys.begin(), keys.end(), (uint16_t)(id >> 16));
+        if (it == keys.end() || *it != (uint16_t)(id >> 16)) return false;
+        return containers[it - keys.begin()].contains((uint16_t)(id & 0xffff));
+    }
+
+    DocIdList toDocIdList() const {
+        DocIdList result;
+        result.reserve(cardinality());
+        for (size_t k = 0; k < keys.size(); k++) {
+            containers[k].appendTo((uint32_t)keys[k] << 16, result);
+        }
+        return result;
+    }
+
+    void runOptimize() {
+        for (RoaringContainer& c : containers) c.runOptimize();
+    }
+
+    size_t memoryBytes() const {
+        size_t total = keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(RoaringContainer);
+        for (const RoaringContainer& c : containers) total += c.memoryBytes();
+        return total;
+    }
+
+    // Set operations
+    static RoaringBitmap andOf(const RoaringBitmap& a, const RoaringBitmap& b) { return apply(a, b, OP_AND); }
+    static RoaringBitmap andNotOf(const RoaringBitmap& a, const RoaringBitmap& b) { return apply(a, b, OP_ANDNOT); }
+
+    // OR of many bitmaps: every key is accumulated once in a 1024-word buffer
+    static RoaringBitmap orMany(const vector<const RoaringBitmap*>& inputs);
+};
+
+RoaringContainer RoaringBitmap::combine(const RoaringContainer& a, const RoaringContainer& b, Operation op) {
+    // Sparse fast paths that never touch a full bitmap
+    if (op == OP_AND && (a.type == RoaringContainer::ARRAY || b.type == RoaringContainer::ARRAY)) {
+        const RoaringContainer& small = (a.type == RoaringContainer::ARRAY) ? a : b;
+        const RoaringContainer& other = (a.type == RoaringContainer::ARRAY) ? b : a;
+        RoaringContainer c;
+        for (uint16_t v : small.values) {
+            if (other.contains(v)) c.values.push_back(v);
+        }
+        c.cardinality = (int)c.values.size();
+        return c;
+    }
+    if (op == OP_ANDNOT && a.type == RoaringContainer::ARRAY) {
+        RoaringContainer c;
+        for (uint16_t v : a.values) {
+            if (!b.contains(v)) c.values.push_back(v);
+        }
+        c.cardinality = (int)c.values.size();
+        return c;
+    }
+
+    // General case: word-level bitwise operation
+    uint64_t wordsA[ROARING_BITMAP_WORDS], wordsB[ROARING_BITMAP_WORDS];
+    a.toWords(wordsA);
+    b.toWords(wordsB);
+    for (int w = 0; w < ROARING_BITMAP_WORDS; w++) {
+        if (op == OP_AND) wordsA[w] &= wordsB[w];
+        else wordsA[w] &= ~wordsB[w];
+    }
+    return RoaringContainer::fromWords(wordsA);
+}
+
+RoaringBitmap RoaringBitmap::apply(const RoaringBitmap& a, const RoaringBitmap& b, Operation op) {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.keys.size() || j < b.keys.size()) {
+        bool hasA = i < a.keys.size(), hasB = j < b.keys.size();
+        if (hasA && (!hasB || a.keys[i] < b.keys[j])) {
+            // Key only in a
+            if (op == OP_ANDNOT) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(a.containers[i]);
+            }
+            i++;
+        } else if (hasB && (!hasA || b.keys[j] < a.keys[i])) {
+            // Key only in b: in neither result
+            j++;
+        } else {
+            RoaringContainer c = combine(a.containers[i], b.containers[j], op);
+            if (c.cardinality > 0) {
+                result.keys.push_back(a.keys[i]);
+                result.containers.push_back(move(c));
+            }
+            i++;
+            j++;
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::orMany(const vector<const RoaringBitmap*>& inputs) {
+    RoaringBitmap result;
+    if (inputs.empty()) return result;
+    if (inputs.size() == 1) return *inputs[0];
+
+    // Every key present in any input, in order
+    vector<uint16_t> allKeys;
+    for (const RoaringBitmap* input : inputs) {
+        allKeys.insert(allKeys.end(), input->keys.begin(), input->keys.end());
+    }
+    sort(allKeys.begin(), allKeys.end());
+    allKeys.erase(unique(allKeys.begin(), allKeys.end()), allKeys.end());
+
+    vector<uint64_t> accumulator(ROARING_BITMAP_WORDS);
+    vector<uint64_t> words(ROARING_BITMAP_WORDS);
+    for (uint16_t key : allKeys) {
+        fill(accumulator.begin(), accumulator.end(), 0);
+        for (const RoaringBitmap* input : inputs) {
+            auto it = lower_bound(input->keys.begin(), input->keys.end(), key);
+            if (it == input->keys.end() || *it != key) continue;
+            const RoaringContainer& c = input->containers[it - input->keys.begin()];
+            if (c.type == RoaringContainer::ARRAY) {
+                for (uint16_t v : c.values) accumulator[v >> 6] |= (uint64_t)1 << (v & 63);
+            } else {
+                c.toWords(words.data());
+                for (int w = 0; w < ROARING_BITMAP_WORDS; w++) accumulator[w] |= words[w];
+            }
+        }
+        result.keys.push_back(key);
+        result.containers.push_back(RoaringContainer::fromWords(accumulator.data()));
+    }
+    return result;
+}
+
+// Term -> RoaringBitmap index (same sorted term table as the PostingIndex it is built from)
+class RoaringIndex {
+private:
+    PostingIndex terms;             // term table (postings kept for iteration / snapshots)
+    vector<RoaringBitmap> bitmaps;  // bitmap of term i
+    RoaringBitmap emptyBitmap;
+
+public:
+    RoaringIndex() {}
+
+    explicit RoaringIndex(const PostingIndex& index) : terms(index) {
+        bitmaps.reserve(index.getTermCount());
+        for (int t = 0; t < index.getTermCount(); t++) {
+            bitmaps.push_back(RoaringBitmap::fromPostings(index.getPostings(t)));
+            bitmaps.back().runOptimize();
+        }
+    }
+
+    const PostingIndex& getPostingIndex() const { return terms; }
+    int getTermCount() const { return terms.getTermCount(); }
+
+    // Bitmap of an exact term (empty bitmap if the term is not indexed)
+    const RoaringBitmap& lookup(string_view term) const {
+        int termId = terms.findTerm(term);
+        return termId < 0 ? emptyBitmap : bitmaps[termId];
+    }
+
+    size_t memoryBytes() const {
+        size_t total = 0;
+        for (const RoaringBitmap& bitmap : bitmaps) total += bitmap.memoryBytes();
+        return total;
+    }
+};
+
+#endif
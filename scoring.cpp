@@ -0,0 +1,478 @@
+#ifndef SCORING_CPP
+#define SCORING_CPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include "skills.cpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define SCORING_X86_KERNELS 1
+#endif
+
+using namespace std;
+
+// Points awarded for every skill a job and a resume have in common
+const int SKILL_MATCH_POINTS = 5;
+
+// Packed skill bitmaps: one SKILL_WORDS-word row per record, stored contiguously
+class SkillMatrix {
+private:
+    vector<uint64_t> words;
+    int rowCount;
+
+public:
+    SkillMatrix(int rows = 0) : words((size_t)rows * SKILL_WORDS, 0), rowCount(rows) {}
+
+    int getRows() const { return rowCount; }
+
+    void setRow(int row, const SkillSet& skills) {
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            words[(size_t)row * SKILL_WORDS + w] = skills.words[w];
+        }
+    }
+
+    const uint64_t* row(int r) const { return words.data() + (size_t)r * SKILL_WORDS; }
+
+    SkillSet getRow(int r) const {
+        SkillSet skills;
+        for (int w = 0; w < SKILL_WORDS; w++) skills.words[w] = row(r)[w];
+        return skills;
+    }
+
+    // Growth, for matrices used as a record store's skill column
+    void addRow(const SkillSet& skills) {
+        words.insert(words.end(), skills.words, skills.words + SKILL_WORDS);
+        rowCount++;
+    }
+    void reserve(int rows) { words.reserve((size_t)rows * SKILL_WORDS); }
+    void clear() {
+        words.clear();
+        rowCount = 0;
+    }
+
+    // Raw words, row after row (snapshots)
+    const vector<uint64_t>& getWords() const { return words; }
+    bool setWords(vector<uint64_t> rowWords) {
+        if (rowWords.size() % SKILL_WORDS != 0) return false;
+        rowCount = (int)(rowWords.size() / SKILL_WORDS);
+        words = move(rowWords);
+        return true;
+    }
+};
+
+// Weighted dot products of one query row against many target rows. For every nonzero byte of
+// the query it holds the summed squared weights of each subset of that byte's bits, so a target
+// costs one lookup per nonzero query byte instead of one per shared skill.
+// Filled by ScoringModel::buildDotTable().
+class WeightedDotTable {
+private:
+    int byteCount;
+    int byteWord[SKILL_WORDS * 8];      // row word holding each nonzero query byte
+    int byteShift[SKILL_WORDS * 8];     // its bit offset within that word
+    vector<uint64_t> sums;              // byteCount x 256, indexed by the target's byte
+
+    friend class ScoringModel;
+
+public:
+    WeightedDotTable() : byteCount(0) {}
+
+    // Summed squared weights of the skills the query shares with target
+    uint64_t dot(const uint64_t* target) const {
+        uint64_t total = 0;
+        for (int b = 0; b < byteCount; b++) {
+            total += sums[b * 256 + ((target[byteWord[b]] >> byteShift[b]) & 0xff)];
+        }
+        return total;
+    }
+};
+
+// Job x resume compatibility model, in fixed point so the hot loop stays in integers.
+//   MODEL_FLAT     - SKILL_MATCH_POINTS per shared skill (popcount of job & resume)
+//   MODEL_WEIGHTED - every skill s has weight w(s) = idf(s) * configured weight(s), and the score
+//                    is the cosine of the two weighted skill vectors, shown as 0-100 points.
+// pairScore() is what rankings compare: shared skills (flat), or dot / |target| (weighted) -
+// dividing by the query norm as well would not change any query's ranking, so that happens
+// only once per query in displayPoints().
+class ScoringModel {
+public:
+    enum Mode { MODEL_FLAT, MODEL_WEIGHTED };
+
+    static constexpr int SQUARED_WEIGHT_SHIFT = 8;  // squaredWeight is Q8
+    static constexpr int INVERSE_NORM_SHIFT = 24;   // inverse norms are Q24
+    static constexpr int PAIR_SCORE_SHIFT = 16;     // weighted pair scores are Q16
+
+private:
+    Mode mode;
+    double configuredWeight[MAX_SKILLS];        // from the weights file, 1.0 by default
+    double idf[MAX_SKILLS];                     // 1.0 until prepare() has seen a corpus
+    uint32_t squaredWeight[MAX_SKILLS];         // w(s)^2 in fixed point
+    int configuredCount;
+
+    void updateWeights() {
+        for (int s = 0; s < MAX_SKILLS; s++) {
+            double weight = idf[s] * configuredWeight[s];
+            squaredWeight[s] = (uint32_t)llround(weight * weight * (1 << SQUARED_WEIGHT_SHIFT));
+        }
+    }
+
+public:
+    ScoringModel() : mode(MODEL_WEIGHTED), configuredCount(0) {
+        for (int s = 0; s < MAX_SKILLS; s++) {
+            configuredWeight[s] = 1.0;
+            idf[s] = 1.0;
+        }
+        updateWeights();
+    }
+
+    Mode getMode() const { return mode; }
+    void setMode(Mode m) { mode = m; }
+    const char* name() const { return mode == MODEL_FLAT ? "Flat" : "IDF-Weighted Cosine"; }
+    int getConfiguredCount() const { return configuredCount; }
+    double getWeight(int skillId) const { return idf[skillId] * configuredWeight[skillId]; }
+
+    // Optional weights file, one setting per line ('#' starts a comment):
+    //   model = flat | weighted
+    //   <skill name> = <weight multiplier>
+    // Returns false if the file cannot be read; bad lines are reported and skipped.
+    bool loadWeights(const string& path);
+
+    // Smoothed IDF over both collections: idf(s) = ln((N + 1) / (df(s) + 1)) + 1
+    void prepare(const SkillMatrix& jobs, const SkillMatrix& resumes) {
+        vector<int> documentFrequency(MAX_SKILLS, 0);
+        const SkillMatrix* corpus[2] = {&jobs, &resumes};
+        for (const SkillMatrix* matrix : corpus) {
+            for (int r = 0; r < matrix->getRows(); r++) {
+                const uint64_t* row = matrix->row(r);
+                for (int w = 0; w < SKILL_WORDS; w++) {
+                    for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                        documentFrequency[w * 64 + countTrailingZeros64(bits)]++;
+                    }
+                }
+            }
+        }
+        double documents = jobs.getRows() + resumes.getRows();
+        for (int s = 0; s < MAX_SKILLS; s++) {
+            idf[s] = log((documents + 1) / (documentFrequency[s] + 1)) + 1;
+        }
+        updateWeights();
+    }
+
+    // 2^24 / |row| (0 for a row without weighted skills)
+    uint32_t inverseNorm(const uint64_t* row) const {
+        uint64_t squaredNorm = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            for (uint64_t bits = row[w]; bits; bits &= bits - 1) {
+                squaredNorm += squaredWeight[w * 64 + countTrailingZeros64(bits)];
+            }
+        }
+        if (squaredNorm == 0) return 0;
+        double norm = sqrt((double)squaredNorm / (1 << SQUARED_WEIGHT_SHIFT));
+        return (uint32_t)llround((1 << INVERSE_NORM_SHIFT) / norm);
+    }
+
+    vector<uint32_t> inverseNorms(const SkillMatrix& rows) const {
+        vector<uint32_t> norms(rows.getRows());
+        for (int r = 0; r < rows.getRows(); r++) norms[r] = inverseNorm(rows.row(r));
+        return norms;
+    }
+
+    // Ranking score of a target row for a query (higher is better, 0 = no match)
+    int64_t pairScore(const uint64_t* query, const uint64_t* target, uint32_t targetInverseNorm) const {
+        if (mode == MODEL_FLAT) {
+            int count = 0;
+            for (int w = 0; w < SKILL_WORDS; w++) count += popcount64(query[w] & target[w]);
+            return count;
+        }
+        uint64_t dot = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            for (uint64_t bits = query[w] & target[w]; bits; bits &= bits - 1) {
+                dot += squaredWeight[w * 64 + countTrailingZeros64(bits)];
+            }
+        }
+        return weightedScore(dot, targetInverseNorm);
+    }
+
+    // Weighted pair score from a dot product (pairScore() of MODEL_WEIGHTED)
+    int64_t weightedScore(uint64_t dot, uint32_t targetInverseNorm) const {
+        const int shift = SQUARED_WEIGHT_SHIFT + INVERSE_NORM_SHIFT - PAIR_SCORE_SHIFT;
+        return (int64_t)((dot * targetInverseNorm + (1ULL << (shift - 1))) >> shift);
+    }
+
+    // Fill table with the weighted dot products of query (weighted model, many targets per query)
+    void buildDotTable(const uint64_t* query, WeightedDotTable& table) const {
+        table.byteCount = 0;
+        for (int i = 0; i < SKILL_WORDS * 8; i++) {
+            if ((query[i / 8] >> (i % 8 * 8)) & 0xff) table.byteCount++;
+        }
+        table.sums.resize((size_t)table.byteCount * 256);
+        int b = 0;
+        for (int i = 0; i < SKILL_WORDS * 8; i++) {
+            unsigned queryByte = (query[i / 8] >> (i % 8 * 8)) & 0xff;
+            if (queryByte == 0) continue;
+            table.byteWord[b] = i / 8;
+            table.byteShift[b] = i % 8 * 8;
+            uint64_t* sums = table.sums.data() + (size_t)b * 256;
+            sums[0] = 0;
+            for (unsigned v = 1; v < 256; v++) {
+                unsigned lowBit = v & (0u - v);
+                sums[v] = sums[v ^ lowBit] + ((queryByte & lowBit) ? squaredWeight[i * 8 + countTrailingZeros64(lowBit)] : 0);
+            }
+            b++;
+        }
+    }
+
+    // Points shown to the user for a pair score
+    int displayPoints(int64_t score, uint32_t queryInverseNorm) const {
+        if (mode == MODEL_FLAT) return (int)score * SKILL_MATCH_POINTS;
+        const int shift = PAIR_SCORE_SHIFT + INVERSE_NORM_SHIFT;
+        return (int)((score * queryInverseNorm * 100 + (1LL << (shift - 1))) >> shift);
+    }
+
+    // Pair score made independent of the query, so pairs of different queries compare
+    // (e.g. in a global assignment): shared skills (flat), or the cosine in Q16 (weighted)
+    int64_t pairWeight(int64_t score, uint32_t queryInverseNorm) const {
+        if (mode == MODEL_FLAT) return score;
+        return (int64_t)((score * queryInverseNorm + (1LL << (INVERSE_NORM_SHIFT - 1))) >> INVERSE_NORM_SHIFT);
+    }
+
+    // Score of one job/resume pair in points
+    int compatibility(const SkillSet& job, const SkillSet& resume) const {
+        return displayPoints(pairScore(job.words, resume.words, inverseNorm(resume.words)), inverseNorm(job.words));
+    }
+};
+
+bool ScoringModel::loadWeights(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        size_t comment = line.find('#');
+        if (comment != string::npos) line.erase(comment);
+        if (line.find_first_not_of(" \t\r") == string::npos) continue;
+
+        size_t equals = line.find('=');
+        string key = equals == string::npos ? "" : line.substr(0, equals);
+        string value = equals == string::npos ? "" : line.substr(equals + 1);
+        key.erase(0, key.find_first_not_of(" \t"));
+        key.erase(key.find_last_not_of(" \t\r") + 1);
+        value.erase(0, value.find_first_not_of(" \t"));
+        value.erase(value.find_last_not_of(" \t\r") + 1);
+
+        if (key == "model" && (value == "flat" || value == "weighted")) {
+            mode = value == "flat" ? MODEL_FLAT : MODEL_WEIGHTED;
+            continue;
+        }
+        int skillId = skillDictionary.findSkill(key);
+        char* end = nullptr;
+        double weight = strtod(value.c_str(), &end);
+        if (skillId < 0 || value.empty() || *end != '\0' || weight < 0) {
+            cerr << "Warning: " << path << ":" << lineNumber << ": ignoring '" << line << "'" << endl;
+            continue;
+        }
+        configuredWeight[skillId] = weight;
+        configuredCount++;
+    }
+    updateWeights();
+    return true;
+}
+
+// Model used by the matcher (configured and prepared by main after loading)
+ScoringModel scoringModel;
+
+// Best-scoring target rows for one query row (a job's resumes, or a resume's jobs)
+struct BestMatch {
+    int64_t bestScore;       // score of the best target(s): shared skills, or a ScoringModel pair score
+    int matchCount;          // targets scoring above zero
+    vector<int> tiedRows;    // every target row that reaches bestScore
+
+    void reset() {
+        bestScore = 0;
+        matchCount = 0;
+        tiedRows.clear();
+    }
+
+    // Account for one target row (rows must arrive in ascending order)
+    void add(int row, int64_t score) {
+        if (score == 0) return;
+        matchCount++;
+        if (score > bestScore) {
+            bestScore = score;
+            tiedRows.clear();
+        }
+        if (score == bestScore) {
+            tiedRows.push_back(row);
+        }
+    }
+};
+
+// Batch job x resume scoring engine.
+// Counts shared skills (popcount of job & resume) for whole rows of resumes at a time,
+// using the widest popcount kernel the CPU supports (picked at runtime).
+class ScoringEngine {
+public:
+    enum Kernel { KERNEL_SCALAR, KERNEL_POPCNT, KERNEL_AVX2, KERNEL_AVX512 };
+
+private:
+    Kernel kernel;
+
+    static void scoreRowScalar(const uint64_t* job, const SkillMatrix& resumes, int first, uint16_t* counts);
+#ifdef SCORING_X86_KERNELS
+    static void scoreRowPopcnt(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts);
+    static void scoreRowAvx2(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts);
+    static void scoreRowAvx512(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts);
+#endif
+
+public:
+    ScoringEngine() : kernel(detectKernel()) {}
+
+    static Kernel detectKernel();
+    const char* kernelName() const;
+
+    // counts[r] = popcount(job & resume r) for every resume row
+    void scoreRow(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts) const;
+};
+
+// Pick the widest kernel supported by this CPU
+ScoringEngine::Kernel ScoringEngine::detectKernel() {
+#ifdef SCORING_X86_KERNELS
+    __builtin_cpu_init();
+    if (SKILL_WORDS == 4) {
+        if (__builtin_cpu_supports("avx512bw")) return KERNEL_AVX512;
+        if (__builtin_cpu_supports("avx2")) return KERNEL_AVX2;
+    }
+    if (__builtin_cpu_supports("popcnt")) return KERNEL_POPCNT;
+#endif
+    return KERNEL_SCALAR;
+}
+
+const char* ScoringEngine::kernelName() const {
+    switch (kernel) {
+        case KERNEL_AVX512: return "AVX-512";
+        case KERNEL_AVX2: return "AVX2";
+        case KERNEL_POPCNT: return "POPCNT";
+        default: return "Scalar";
+    }
+}
+
+// Portable fallback (also used for the tail rows of the SIMD kernels)
+void ScoringEngine::scoreRowScalar(const uint64_t* job, const SkillMatrix& resumes, int first, uint16_t* counts) {
+    for (int r = first; r < resumes.getRows(); r++) {
+        const uint64_t* resume = resumes.row(r);
+        int count = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            count += popcount64(job[w] & resume[w]);
+        }
+        counts[r] = (uint16_t)count;
+    }
+}
+
+#ifdef SCORING_X86_KERNELS
+// Per-qword popcount of (job & resume) for one 256-bit row (nibble lookup table)
+__attribute__((target("avx2"), always_inline))
+static inline __m256i rowCountsAvx2(__m256i jobRow, const uint64_t* resume) {
+    const __m256i lut = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                         0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    __m256i v = _mm256_and_si256(jobRow, _mm256_loadu_si256((const __m256i*)resume));
+    __m256i lo = _mm256_shuffle_epi8(lut, _mm256_and_si256(v, lowMask));
+    __m256i hi = _mm256_shuffle_epi8(lut, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask));
+    return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+}
+
+// Per-qword popcount of (job & resume) for two adjacent 256-bit rows
+__attribute__((target("avx512f,avx512bw"), always_inline))
+static inline __m512i pairCountsAvx512(__m512i jobRows, const uint64_t* resumes) {
+    const __m512i lut = _mm512_broadcast_i32x4(_mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+    const __m512i lowMask = _mm512_set1_epi8(0x0f);
+    __m512i v = _mm512_and_si512(jobRows, _mm512_loadu_si512((const void*)resumes));
+    __m512i lo = _mm512_shuffle_epi8(lut, _mm512_and_si512(v, lowMask));
+    __m512i hi = _mm512_shuffle_epi8(lut, _mm512_and_si512(_mm512_srli_epi16(v, 4), lowMask));
+    return _mm512_sad_epu8(_mm512_add_epi8(lo, hi), _mm512_setzero_si512());
+}
+
+// Scalar loop compiled with the hardware POPCNT instruction
+__attribute__((target("popcnt")))
+void ScoringEngine::scoreRowPopcnt(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts) {
+    for (int r = 0; r < resumes.getRows(); r++) {
+        const uint64_t* resume = resumes.row(r);
+        int count = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            count += __builtin_popcountll(job[w] & resume[w]);
+        }
+        counts[r] = (uint16_t)count;
+    }
+}
+
+// AVX2: one 256-bit row per register, nibble-LUT popcount, 4 resumes reduced together
+__attribute__((target("avx2")))
+void ScoringEngine::scoreRowAvx2(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts) {
+    const __m256i jobRow = _mm256_loadu_si256((const __m256i*)job);
+
+    int rows = resumes.getRows();
+    int r = 0;
+    for (; r + 4 <= rows; r += 4) {
+        __m256i a = rowCountsAvx2(jobRow, resumes.row(r));
+        __m256i b = rowCountsAvx2(jobRow, resumes.row(r + 1));
+        __m256i c = rowCountsAvx2(jobRow, resumes.row(r + 2));
+        __m256i d = rowCountsAvx2(jobRow, resumes.row(r + 3));
+        // [a01 b01 | a23 b23] and [c01 d01 | c23 d23] -> [a b c d]
+        __m256i ab = _mm256_add_epi64(_mm256_unpacklo_epi64(a, b), _mm256_unpackhi_epi64(a, b));
+        __m256i cd = _mm256_add_epi64(_mm256_unpacklo_epi64(c, d), _mm256_unpackhi_epi64(c, d));
+        __m256i sum = _mm256_add_epi64(_mm256_permute2x128_si256(ab, cd, 0x20),
+                                       _mm256_permute2x128_si256(ab, cd, 0x31));
+        alignas(32) uint64_t out[4];
+        _mm256_store_si256((__m256i*)out, sum);
+        for (int k = 0; k < 4; k++) counts[r + k] = (uint16_t)out[k];
+    }
+    scoreRowScalar(job, resumes, r, counts);
+}
+
+// AVX-512BW: two rows per register, 8 resumes reduced together
+__attribute__((target("avx512f,avx512bw")))
+void ScoringEngine::scoreRowAvx512(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts) {
+    const __m512i jobRows = _mm512_broadcast_i64x4(_mm256_loadu_si256((const __m256i*)job));
+    const __m512i order = _mm512_setr_epi64(0, 2, 1, 3, 4, 6, 5, 7);
+
+    int rows = resumes.getRows();
+    int r = 0;
+    for (; r + 8 <= rows; r += 8) {
+        // Rows are adjacent in memory, so each 512-bit load covers rows r and r + 1
+        __m512i z0 = pairCountsAvx512(jobRows, resumes.row(r));
+        __m512i z1 = pairCountsAvx512(jobRows, resumes.row(r + 2));
+        __m512i z2 = pairCountsAvx512(jobRows, resumes.row(r + 4));
+        __m512i z3 = pairCountsAvx512(jobRows, resumes.row(r + 6));
+        // 128-bit lanes become [half sums of r0, r2], [other half r0, r2], [r1, r3], [r1, r3]
+        __m512i u01 = _mm512_add_epi64(_mm512_unpacklo_epi64(z0, z1), _mm512_unpackhi_epi64(z0, z1));
+        __m512i u23 = _mm512_add_epi64(_mm512_unpacklo_epi64(z2, z3), _mm512_unpackhi_epi64(z2, z3));
+        u01 = _mm512_add_epi64(u01, _mm512_shuffle_i64x2(u01, u01, _MM_SHUFFLE(2, 3, 0, 1)));
+        u23 = _mm512_add_epi64(u23, _mm512_shuffle_i64x2(u23, u23, _MM_SHUFFLE(2, 3, 0, 1)));
+        // [r0 r2 r1 r3 r4 r6 r5 r7] -> [r0 .. r7]
+        __m512i sum = _mm512_shuffle_i64x2(u01, u23, _MM_SHUFFLE(2, 0, 2, 0));
+        sum = _mm512_permutexvar_epi64(order, sum);
+        _mm_storeu_si128((__m128i*)(counts + r), _mm512_cvtepi64_epi16(sum));
+    }
+    scoreRowScalar(job, resumes, r, counts);
+}
+#endif
+
+void ScoringEngine::scoreRow(const uint64_t* job, const SkillMatrix& resumes, uint16_t* counts) const {
+#ifdef SCORING_X86_KERNELS
+    switch (kernel) {
+        case KERNEL_AVX512: scoreRowAvx512(job, resumes, counts); return;
+        case KERNEL_AVX2: scoreRowAvx2(job, resumes, counts); return;
+        case KERNEL_POPCNT: scoreRowPopcnt(job, resumes, counts); return;
+        default: break;
+    }
+#endif
+    scoreRowScalar(job, resumes, 0, counts);
+}
+
+#endif
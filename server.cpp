@@ -0,0 +1,521 @@
+#ifndef SERVER_CPP
+#define SERVER_CPP
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include "array.cpp"
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+#endif
+using namespace std;
+
+// Resident matching server: keeps both collections and their indexes loaded and answers
+// queries over a Unix domain socket or localhost TCP with a line protocol.
+//
+// Requests, one per line (N = results to return, 0 = all):
+//   TITLE N <text>      jobs by title
+//   SKILLS N <text>     jobs by skills (same syntax as the menu)
+//   RESUMES N <text>    resumes by skills
+//   MATCH N <job id>    best resumes for one job (all tied at the best score)
+//   STATS               request counts and p50 / p99 / max latency per command
+//   PING, QUIT
+// Responses: "OK <rows>" followed by that many lines ("<rank> <id> <score>" for queries),
+// or "ERR <message>". Requests on one connection are answered in order.
+
+struct ServerOptions {
+    string socketPath;  // Unix domain socket, or
+    int tcpPort;        // localhost TCP port (0 = not used)
+    int numThreads;     // query workers, 0 = all cores
+
+    ServerOptions() : tcpPort(0), numThreads(0) {}
+};
+
+// True if the command line asks for server mode
+bool isServerInvocation(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--serve") == 0 || strcmp(argv[i], "--port") == 0) return true;
+    }
+    return false;
+}
+
+void printServerUsage(ostream& out) {
+    out << "Usage: program --serve SOCKET_PATH [--threads N]\n"
+        << "       program --port PORT [--threads N]      (listens on 127.0.0.1)\n";
+}
+
+bool parseServerOptions(int argc, char* argv[], ServerOptions& options, string& error) {
+    for (int i = 1; i < argc; i++) {
+        string flag = argv[i];
+        if (flag != "--serve" && flag != "--port" && flag != "--threads") {
+            error = "unknown server option " + flag;
+            return false;
+        }
+        if (i + 1 >= argc) {
+            error = "missing value for " + flag;
+            return false;
+        }
+        string value = argv[++i];
+        if (flag == "--serve") {
+            options.socketPath = value;
+            continue;
+        }
+        char* end = nullptr;
+        long number = strtol(value.c_str(), &end, 10);
+        long limit = flag == "--port" ? 65535 : 4096;
+        if (value.empty() || *end != '\0' || number < 0 || number > limit) {
+            error = "invalid number for " + flag + ": " + value;
+            return false;
+        }
+        if (flag == "--port") options.tcpPort = (int)number;
+        else options.numThreads = (int)number;
+    }
+    if (options.socketPath.empty() == (options.tcpPort == 0)) {
+        error = "give either --serve SOCKET_PATH or --port PORT";
+        return false;
+    }
+    return true;
+}
+
+// Latency histogram: 8 linear sub-buckets per power of two microseconds (at most 12.5% error)
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BUCKETS = 8;
+    static constexpr int BUCKETS = 62 * SUB_BUCKETS;
+
+    vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t maxMicros;
+
+    static int bucketOf(uint64_t micros) {
+        if (micros < SUB_BUCKETS) return (int)micros;
+        int exponent = 63 - __builtin_clzll(micros); // >= 3
+        int sub = (int)(micros >> (exponent - 3)) - SUB_BUCKETS;
+        return (exponent - 2) * SUB_BUCKETS + sub;
+    }
+
+    // Largest value that falls in a bucket
+    static uint64_t bucketLimit(int bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+        int exponent = bucket / SUB_BUCKETS + 2;
+        uint64_t low = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << (exponent - 3);
+        return low + (1ULL << (exponent - 3)) - 1;
+    }
+
+public:
+    LatencyHistogram() : counts(BUCKETS, 0), total(0), maxMicros(0) {}
+
+    void record(uint64_t micros) {
+        counts[bucketOf(micros)]++;
+        total++;
+        maxMicros = max(maxMicros, micros);
+    }
+
+    uint64_t count() const { return total; }
+    uint64_t maximum() const { return maxMicros; }
+
+    // Upper bound of the given percentile (0-100)
+    uint64_t percentile(double p) const {
+        if (total == 0) return 0;
+        uint64_t rank = (uint64_t)(p / 100.0 * total + 0.999999);
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b];
+            if (seen >= rank) return min(bucketLimit(b), maxMicros);
+        }
+        return maxMicros;
+    }
+};
+
+#ifdef __linux__
+
+// Server-side state shared by the event loop and the query workers (read-only while serving)
+class MatchServer {
+private:
+    enum Command { CMD_TITLE, CMD_SKILLS, CMD_RESUMES, CMD_MATCH, COMMAND_COUNT };
+
+    static constexpr uint64_t LISTEN_KEY = 0;   // epoll keys; connections start at FIRST_CONNECTION
+    static constexpr uint64_t WAKE_KEY = 1;
+    static constexpr uint64_t SIGNAL_KEY = 2;
+    static constexpr uint64_t FIRST_CONNECTION = 3;
+    static constexpr size_t MAX_LINE_BYTES = 64 * 1024;
+
+    struct Connection {
+        int fd;
+        string input;           // bytes not yet parsed into requests
+        string output;          // response bytes not yet sent
+        bool busy;              // a request is with the workers (one at a time keeps order)
+        bool peerClosed;
+        bool closeAfterWrite;
+        bool watched;           // registered with epoll
+    };
+
+    struct Completion {
+        uint64_t connection;
+        Command command;
+        string response;
+        chrono::steady_clock::time_point started;
+    };
+
+    const Array<Job>& jobs;
+    const Array<Resume>& resumes;
+    ScoringEngine engine;
+    CandidateScorer<Resume> resumeScorer;
+    const SkillMatrix& jobMatrix;
+    unordered_map<int, int> jobRowById;
+
+    WorkStealingPool pool;
+    mutex completionLock;
+    vector<Completion> completions;
+    int epollFd, wakeFd, signalFd, listenFd;
+    unordered_map<uint64_t, Connection> connections;
+    uint64_t nextConnection;
+    LatencyHistogram latency[COMMAND_COUNT];
+    LatencyHistogram allLatency;
+
+    static const char* commandName(Command command) {
+        static const char* const NAMES[] = {"TITLE", "SKILLS", "RESUMES", "MATCH"};
+        return NAMES[command];
+    }
+
+    static string formatRows(const vector<Match>& rows, const Array<Job>* jobIds, const Array<Resume>* resumeIds) {
+        string out = "OK " + to_string(rows.size()) + "\n";
+        for (size_t i = 0; i < rows.size(); i++) {
+            int id = jobIds != nullptr ? jobIds->getId(rows[i].index) : resumeIds->getId(rows[i].index);
+            out += to_string(i + 1) + " " + to_string(id) + " " + to_string(rows[i].score) + "\n";
+        }
+        return out;
+    }
+
+    // Runs on a worker thread
+    string answer(Command command, int top, const string& text) const {
+        if (command == CMD_TITLE) return formatRows(jobs.searchByTitle(text, top > 0 ? top : max(1, jobs.getSize())), &jobs, nullptr);
+        if (command == CMD_SKILLS) return formatRows(jobs.searchBySkills(text, top > 0 ? top : max(1, jobs.getSize())), &jobs, nullptr);
+        if (command == CMD_RESUMES) return formatRows(resumes.searchBySkills(text, top > 0 ? top : max(1, resumes.getSize())), nullptr, &resumes);
+
+        char* end = nullptr;
+        long jobId = strtol(text.c_str(), &end, 10);
+        auto found = *end == '\0' ? jobRowById.find((int)jobId) : jobRowById.end();
+        if (text.empty() || found == jobRowById.end()) return "ERR unknown job id " + text + "\n";
+        int row = found->second;
+        BestMatch best;
+        best.reset();
+        CandidateScratch scratch;
+        resumeScorer.scoreQuery(jobMatrix.row(row), scratch, [&](int target, int64_t score) { best.add(target, score); });
+        int points = scoringModel.displayPoints(best.bestScore, scoringModel.inverseNorm(jobMatrix.row(row)));
+        vector<Match> rows;
+        for (int target : best.tiedRows) {
+            if (top > 0 && (int)rows.size() == top) break;
+            rows.push_back(Match{target, points});
+        }
+        return formatRows(rows, nullptr, &resumes);
+    }
+
+    string statsResponse() const {
+        string out = "OK " + to_string(COMMAND_COUNT + 1) + "\n";
+        for (int c = 0; c <= COMMAND_COUNT; c++) {
+            const LatencyHistogram& h = c < COMMAND_COUNT ? latency[c] : allLatency;
+            out += string(c < COMMAND_COUNT ? commandName((Command)c) : "ALL") + " count=" + to_string(h.count())
+                 + " p50_us=" + to_string(h.percentile(50)) + " p99_us=" + to_string(h.percentile(99))
+                 + " max_us=" + to_string(h.maximum()) + "\n";
+        }
+        return out;
+    }
+
+    // Parse and start the next requests of a connection until one goes to the workers
+    void pumpRequests(uint64_t key, Connection& conn) {
+        while (!conn.busy && !conn.closeAfterWrite) {
+            size_t newline = conn.input.find('\n');
+            if (newline == string::npos) {
+                if (conn.input.size() > MAX_LINE_BYTES) {
+                    conn.output += "ERR request line too long\n";
+                    conn.closeAfterWrite = true;
+                }
+                return;
+            }
+            string line = conn.input.substr(0, newline);
+            conn.input.erase(0, newline + 1);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (line.empty()) continue;
+
+            size_t space = line.find(' ');
+            string verb = line.substr(0, space);
+            if (verb == "PING") { conn.output += "OK 0\n"; continue; }
+            if (verb == "STATS") { conn.output += statsResponse(); continue; }
+            if (verb == "QUIT") { conn.output += "OK 0\n"; conn.closeAfterWrite = true; return; }
+
+            Command command;
+            if (verb == "TITLE") command = CMD_TITLE;
+            else if (verb == "SKILLS") command = CMD_SKILLS;
+            else if (verb == "RESUMES") command = CMD_RESUMES;
+            else if (verb == "MATCH") command = CMD_MATCH;
+            else { conn.output += "ERR unknown command " + verb + "\n"; continue; }
+
+            // "<verb> <top> <text>"
+            string rest = space == string::npos ? "" : line.substr(space + 1);
+            size_t textStart = rest.find(' ');
+            string topText = rest.substr(0, textStart);
+            string text = textStart == string::npos ? "" : rest.substr(textStart + 1);
+            char* end = nullptr;
+            long top = strtol(topText.c_str(), &end, 10);
+            if (topText.empty() || *end != '\0' || top < 0 || text.empty()) {
+                conn.output += "ERR usage: " + verb + " <count> <text>\n";
+                continue;
+            }
+
+            conn.busy = true;
+            auto started = chrono::steady_clock::now();
+            pool.submit([this, key, command, top, text, started](int) {
+                Completion done = {key, command, answer(command, (int)top, text), started};
+                {
+                    lock_guard<mutex> guard(completionLock);
+                    completions.push_back(move(done));
+                }
+                uint64_t one = 1;
+                if (write(wakeFd, &one, sizeof(one)) < 0) { /* counter saturated: the loop is awake anyway */ }
+            });
+        }
+    }
+
+    // Watch for input while the peer may still send, and for writability while output waits.
+    // A closed peer keeps reporting (level-triggered) hang-ups, so it is only watched for output.
+    void updateInterest(uint64_t key, Connection& conn) {
+        epoll_event event = {};
+        uint32_t events = 0;
+        if (!conn.peerClosed) events |= (uint32_t)EPOLLIN | (uint32_t)EPOLLRDHUP;
+        if (!conn.output.empty()) events |= (uint32_t)EPOLLOUT;
+        event.events = events;
+        event.data.u64 = key;
+        if (event.events == 0) {
+            if (conn.watched) epoll_ctl(epollFd, EPOLL_CTL_DEL, conn.fd, nullptr);
+            conn.watched = false;
+            return;
+        }
+        epoll_ctl(epollFd, conn.watched ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, conn.fd, &event);
+        conn.watched = true;
+    }
+
+    void closeConnection(uint64_t key) {
+        auto it = connections.find(key);
+        if (it == connections.end()) return;
+        if (it->second.watched) epoll_ctl(epollFd, EPOLL_CTL_DEL, it->second.fd, nullptr);
+        close(it->second.fd);
+        connections.erase(it);
+    }
+
+    // Send what the socket takes; close finished connections. Returns false if closed.
+    bool flushConnection(uint64_t key, Connection& conn) {
+        while (!conn.output.empty()) {
+            ssize_t sent = send(conn.fd, conn.output.data(), conn.output.size(), MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                closeConnection(key);
+                return false;
+            }
+            conn.output.erase(0, sent);
+        }
+        bool drained = conn.output.empty() && !conn.busy;
+        if (drained && (conn.closeAfterWrite || (conn.peerClosed && conn.input.find('\n') == string::npos))) {
+            closeConnection(key);
+            return false;
+        }
+        updateInterest(key, conn);
+        return true;
+    }
+
+    void acceptConnections() {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return; // EAGAIN: accepted everything pending
+            uint64_t key = nextConnection++;
+            Connection conn = {fd, "", "", false, false, false, false};
+            updateInterest(key, connections.emplace(key, move(conn)).first->second);
+        }
+    }
+
+    void readConnection(uint64_t key, Connection& conn) {
+        char buffer[16384];
+        while (true) {
+            ssize_t got = recv(conn.fd, buffer, sizeof(buffer), 0);
+            if (got > 0) {
+                conn.input.append(buffer, got);
+                continue;
+            }
+            if (got == 0) conn.peerClosed = true;
+            else if (errno == EINTR) continue;
+            else if (errno != EAGAIN && errno != EWOULDBLOCK) conn.peerClosed = true;
+            break;
+        }
+        pumpRequests(key, conn);
+        flushConnection(key, conn);
+    }
+
+    void deliverCompletions() {
+        uint64_t counter;
+        if (read(wakeFd, &counter, sizeof(counter)) < 0) { /* nothing pending */ }
+        vector<Completion> ready;
+        {
+            lock_guard<mutex> guard(completionLock);
+            ready.swap(completions);
+        }
+        auto now = chrono::steady_clock::now();
+        for (Completion& done : ready) {
+            uint64_t micros = chrono::duration_cast<chrono::microseconds>(now - done.started).count();
+            latency[done.command].record(micros);
+            allLatency.record(micros);
+            auto it = connections.find(done.connection);
+            if (it == connections.end()) continue; // client went away
+            Connection& conn = it->second;
+            conn.output += done.response;
+            conn.busy = false;
+            pumpRequests(done.connection, conn);
+            flushConnection(done.connection, conn);
+        }
+    }
+
+    bool openListener(const ServerOptions& options) {
+        if (!options.socketPath.empty()) {
+            sockaddr_un address = {};
+            if (options.socketPath.size() >= sizeof(address.sun_path)) {
+                cerr << "Error: Socket path too long: " << options.socketPath << endl;
+                return false;
+            }
+            address.sun_family = AF_UNIX;
+            strcpy(address.sun_path, options.socketPath.c_str());
+            unlink(options.socketPath.c_str()); // stale socket from an earlier run
+            listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (listenFd < 0 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0) {
+                cerr << "Error: Cannot bind " << options.socketPath << ": " << strerror(errno) << endl;
+                return false;
+            }
+        } else {
+            sockaddr_in address = {};
+            address.sin_family = AF_INET;
+            address.sin_port = htons((uint16_t)options.tcpPort);
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            int reuse = 1;
+            if (listenFd >= 0) setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (listenFd < 0 || bind(listenFd, (sockaddr*)&address, sizeof(address)) != 0) {
+                cerr << "Error: Cannot bind 127.0.0.1:" << options.tcpPort << ": " << strerror(errno) << endl;
+                return false;
+            }
+        }
+        if (listen(listenFd, SOMAXCONN) != 0) {
+            cerr << "Error: listen failed: " << strerror(errno) << endl;
+            return false;
+        }
+        return true;
+    }
+
+public:
+    MatchServer(const Array<Job>& jobStorage, const Array<Resume>& resumeStorage, int numThreads)
+        : jobs(jobStorage), resumes(resumeStorage), resumeScorer(resumeStorage, engine),
+          jobMatrix(jobStorage.getSkillMatrix()), pool(numThreads),
+          epollFd(-1), wakeFd(-1), signalFd(-1), listenFd(-1), nextConnection(FIRST_CONNECTION) {
+        const_cast<Array<Job>&>(jobs).buildIndex();
+        for (int j = 0; j < jobs.getSize(); j++) {
+            if (jobs.isLive(j)) jobRowById[jobs.getId(j)] = j;
+        }
+    }
+
+    ~MatchServer() {
+        pool.wait(); // workers may still be posting completions
+        for (auto& entry : connections) close(entry.second.fd);
+        if (listenFd >= 0) close(listenFd);
+        if (signalFd >= 0) close(signalFd);
+        if (wakeFd >= 0) close(wakeFd);
+        if (epollFd >= 0) close(epollFd);
+    }
+
+    // Serve until SIGINT / SIGTERM; signalMask must already be blocked in every thread
+    int run(const ServerOptions& options, const sigset_t& signalMask) {
+        if (!openListener(options)) return 1;
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        signalFd = signalfd(-1, &signalMask, SFD_NONBLOCK | SFD_CLOEXEC);
+        if (epollFd < 0 || wakeFd < 0 || signalFd < 0) {
+            cerr << "Error: Cannot set up the event loop: " << strerror(errno) << endl;
+            return 1;
+        }
+        const pair<int, uint64_t> sources[] = {{listenFd, LISTEN_KEY}, {wakeFd, WAKE_KEY}, {signalFd, SIGNAL_KEY}};
+        for (const pair<int, uint64_t>& source : sources) {
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.u64 = source.second;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, source.first, &event);
+        }
+
+        cout << "Serving on " << (options.socketPath.empty() ? "127.0.0.1:" + to_string(options.tcpPort) : options.socketPath)
+             << " with " << pool.getThreadCount() << " worker thread(s) (Ctrl+C to stop)" << endl;
+
+        const int MAX_EVENTS = 256;
+        epoll_event events[MAX_EVENTS];
+        bool running = true;
+        while (running) {
+            int ready = epoll_wait(epollFd, events, MAX_EVENTS, -1);
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                cerr << "Error: epoll_wait failed: " << strerror(errno) << endl;
+                break;
+            }
+            for (int e = 0; e < ready; e++) {
+                uint64_t key = events[e].data.u64;
+                if (key == LISTEN_KEY) acceptConnections();
+                else if (key == WAKE_KEY) deliverCompletions();
+                else if (key == SIGNAL_KEY) running = false;
+                else {
+                    auto it = connections.find(key);
+                    if (it == connections.end()) continue;
+                    if (events[e].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) readConnection(key, it->second);
+                    else flushConnection(key, it->second);
+                }
+            }
+        }
+
+        string stats = statsResponse();
+        cout << "\nShutting down server..." << endl;
+        cout << stats.substr(stats.find('\n') + 1);
+        if (!options.socketPath.empty()) unlink(options.socketPath.c_str());
+        return 0;
+    }
+};
+
+int runServer(const ServerOptions& options, const Array<Job>& jobStorage, const Array<Resume>& resumeStorage) {
+    // Block the stop signals before any worker starts, so only the signalfd sees them
+    sigset_t signalMask;
+    sigemptyset(&signalMask);
+    sigaddset(&signalMask, SIGINT);
+    sigaddset(&signalMask, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signalMask, nullptr);
+
+    MatchServer server(jobStorage, resumeStorage, options.numThreads);
+    return server.run(options, signalMask);
+}
+
+#else
+
+int runServer(const ServerOptions&, const Array<Job>&, const Array<Resume>&) {
+    cerr << "Error: Server mode needs Linux (epoll)" << endl;
+    return 1;
+}
+
+#endif
+
+#endif
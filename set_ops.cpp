@@ -0,0 +1,118 @@
+#ifndef SET_OPS_CPP
+#define SET_OPS_CPP
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include "skills.cpp"
+#include "posting_index.cpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define SET_OPS_SSE2 1
+#endif
+
+using namespace std;
+
+// Set-algebra kernels over sorted, duplicate-free arrays of document IDs.
+// Every intersect* kernel writes the result to out (which must hold min(n, m) entries
+// and must not overlap either input) and returns the number of IDs written.
+
+// Size ratio above which galloping beats a linear merge
+const int GALLOP_RATIO = 32;
+
+// Plain linear merge
+inline int intersectScalar(const int* a, int n, const int* b, int m, int* out) {
+    int i = 0, j = 0, count = 0;
+    while (i < n && j < m) {
+        if (a[i] < b[j]) i++;
+        else if (a[i] > b[j]) j++;
+        else { out[count++] = a[i]; i++; j++; }
+    }
+    return count;
+}
+
+// Galloping (exponential) search: for every ID of the small list, skip ahead in the large one
+inline int intersectGalloping(const int* small, int n, const int* large, int m, int* out) {
+    int count = 0;
+    int low = 0;
+    for (int i = 0; i < n && low < m; i++) {
+        int target = small[i];
+        if (large[low] < target) {
+            // Double the step until we pass the target, then binary search that window
+            int step = 1;
+            int high = low + 1;
+            while (high < m && large[high] < target) {
+                low = high;
+                step *= 2;
+                high = low + step;
+            }
+            if (high > m) high = m;
+            low = (int)(lower_bound(large + low + 1, large + high, target) - large);
+            if (low >= m) break;
+        }
+        if (large[low] == target) {
+            out[count++] = target;
+            low++;
+        }
+    }
+    return count;
+}
+
+#ifdef SET_OPS_SSE2
+// SIMD block intersection: compares a block of 4 IDs against a block of 4 IDs
+// (all 16 pairs via three lane rotations), then advances the block with the smaller maximum
+inline int intersectSimd(const int* a, int n, const int* b, int m, int* out) {
+    int i = 0, j = 0, count = 0;
+    while (i + 4 <= n && j + 4 <= m) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        __m128i eq = _mm_cmpeq_epi32(va, vb);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        while (mask) {
+            int lane = countTrailingZeros64((uint64_t)mask);
+            out[count++] = a[i + lane];
+            mask &= mask - 1;
+        }
+        int maxA = a[i + 3], maxB = b[j + 3];
+        if (maxA <= maxB) i += 4;
+        if (maxB <= maxA) j += 4;
+    }
+    return count + intersectScalar(a + i, n - i, b + j, m - j, out + count);
+}
+#else
+inline int intersectSimd(const int* a, int n, const int* b, int m, int* out) {
+    return intersectScalar(a, n, b, m, out);
+}
+#endif
+
+// Pick a kernel by list sizes: galloping for skewed lists, SIMD blocks for similar sizes
+inline int intersectSorted(const int* a, int n, const int* b, int m, int* out) {
+    if (n > m) { swap(a, b); swap(n, m); }
+    if (n == 0) return 0;
+    if ((long long)n * GALLOP_RATIO < m) return intersectGalloping(a, n, b, m, out);
+    return intersectSimd(a, n, b, m, out);
+}
+
+// AND of several posting lists, smallest list first so the running result only shrinks
+inline DocIdList intersectPostings(vector<PostingSpan> lists) {
+    if (lists.empty()) return DocIdList();
+    sort(lists.begin(), lists.end(), [](const PostingSpan& x, const PostingSpan& y) { return x.size() < y.size(); });
+
+    DocIdList result = lists[0].decode();
+    DocIdList decoded, intersection;
+    for (size_t k = 1; k < lists.size() && !result.empty(); k++) {
+        decoded.resize(lists[k].size());
+        lists[k].decodeTo(decoded.data());
+        intersection.resize(result.size());
+        int count = intersectSorted(result.data(), (int)result.size(), decoded.data(), (int)decoded.size(), intersection.data());
+        intersection.resize(count);
+        result.swap(intersection);
+    }
+    return result;
+}
+
+#endif
@@ -0,0 +1,551 @@
+#ifndef SKILLS_CPP
+#define SKILLS_CPP
+
+#include <string>
+#include <cstdint>
+#include <cctype>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <map>
+#include <fstream>
+#include <iostream>
+using namespace std;
+
+// Master whitelist of technical skills recognised by the system (skill ID = position).
+// Shared by the data cleaner and the loaders; the lookup table below is generated from it
+// at compile time.
+constexpr string_view technicalSkills[] = {
+    "SQL", "Python", "Java", "JavaScript", "C++", "C#", "R", "Scala", "Go", "Rust",
+    "Power BI", "Tableau", "Excel", "Pandas", "NumPy", "Matplotlib", "Seaborn",
+    "Machine Learning", "Deep Learning", "NLP", "Computer Vision", "Statistics",
+    "TensorFlow", "PyTorch", "Keras", "Scikit-learn", "MLOps", "ML",
+    "REST APIs", "Spring Boot", "Docker", "Kubernetes", "Git", "Agile", "Scrum",
+    "System Design", "Microservices", "AWS", "Azure", "GCP", "Cloud",
+    "Data Cleaning", "Data Analysis", "Reporting", "ETL", "Data Pipeline",
+    "Product Roadmap", "User Stories", "Stakeholder Management", "Project Management",
+    "React", "Angular", "Vue", "Node.js", "Express", "Django", "Flask",
+    "MongoDB", "PostgreSQL", "MySQL", "Redis", "Elasticsearch",
+    "Linux", "Windows", "macOS", "Bash", "Shell", "DevOps", "CI/CD"
+};
+constexpr int numTechnicalSkills = sizeof(technicalSkills) / sizeof(technicalSkills[0]);
+
+// Skill vectors are fixed-width: 4 x 64 bits = up to 256 distinct skills
+const int SKILL_WORDS = 4;
+const int MAX_SKILLS = SKILL_WORDS * 64;
+
+// Bit helpers (compiler builtins where available)
+inline int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    while (x) { x &= x - 1; count++; }
+    return count;
+#endif
+}
+
+inline int countTrailingZeros64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(x);
+#else
+    int count = 0;
+    while (!(x & 1)) { x >>= 1; count++; }
+    return count;
+#endif
+}
+
+// Normalize a key: lowercase + remove punctuation + trim (same rules as Array<T>::normalizeText)
+inline string normalizeKey(const string& text) {
+    string normalized;
+    normalized.reserve(text.size());
+    for (unsigned char c : text) {
+        if (ispunct(c)) continue;
+        normalized += (char)tolower(c);
+    }
+    size_t start = normalized.find_first_not_of(" \t\n\r");
+    size_t end = normalized.find_last_not_of(" \t\n\r");
+    if (start == string::npos) return "";
+    return normalized.substr(start, end - start + 1);
+}
+
+static_assert(numTechnicalSkills <= MAX_SKILLS, "too many whitelisted skills for a SkillSet");
+
+// ASCII case folding (what tolower does in the "C" locale the program runs in)
+constexpr unsigned char foldSkillChar(unsigned char c) { return c >= 'A' && c <= 'Z' ? (unsigned char)(c + 32) : c; }
+
+// FNV-1a over the case-folded text, finished with a multiply that spreads the low-entropy
+// FNV bits to the top (slots are taken from the high bits)
+constexpr uint64_t skillNameHash(string_view text, uint64_t seed) {
+    uint64_t h = 14695981039346656037ULL ^ seed;
+    for (size_t i = 0; i < text.size(); i++) {
+        h ^= foldSkillChar((unsigned char)text[i]);
+        h *= 1099511628211ULL;
+    }
+    return h * 0x9E3779B97F4A7C15ULL;
+}
+
+// Collision-free (perfect) hash table over the case-folded whitelist, for a table of 2^Bits slots
+template<int Bits>
+struct SkillHashTable {
+    static constexpr int SLOTS = 1 << Bits;
+    static constexpr int SHIFT = 64 - Bits;
+
+    uint64_t seed;
+    int16_t slots[SLOTS];   // skill ID or -1
+
+    // Fill the slots for seed; false if two names collide
+    constexpr bool place(uint64_t candidateSeed) {
+        seed = candidateSeed;
+        for (int s = 0; s < SLOTS; s++) slots[s] = -1;
+        for (int id = 0; id < numTechnicalSkills; id++) {
+            int slot = (int)(skillNameHash(technicalSkills[id], seed) >> SHIFT);
+            if (slots[slot] >= 0) return false;
+            slots[slot] = (int16_t)id;
+        }
+        return true;
+    }
+
+    // Skill ID of an exact (untrimmed) name, ignoring case; -1 if unknown.
+    // One hash, one slot probe and one compare - no allocation, no lowercased copy.
+    constexpr int find(string_view text) const {
+        int id = slots[skillNameHash(text, seed) >> SHIFT];
+        if (id < 0) return -1;
+        string_view key = technicalSkills[id];
+        if (key.size() != text.size()) return -1;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (foldSkillChar((unsigned char)text[i]) != foldSkillChar((unsigned char)key[i])) return -1;
+        }
+        return id;
+    }
+};
+
+const uint64_t SKILL_HASH_SEEDS = 64;   // seeds tried per table size
+
+// Smallest collision-free seed for a table of 2^bits slots, or SKILL_HASH_SEEDS if none is
+template<int Bits>
+constexpr uint64_t findSkillHashSeed() {
+    SkillHashTable<Bits> table{};
+    for (uint64_t seed = 0; seed < SKILL_HASH_SEEDS; seed++) {
+        if (table.place(seed)) return seed;
+    }
+    return SKILL_HASH_SEEDS;
+}
+
+// Table size: ~4x the whitelist (as few probes as possible land on an empty slot), widened until a
+// seed is collision-free. Names that are equal ignoring case always collide, so they fail here.
+constexpr int smallestSkillHashBits() {
+    int bits = 2;
+    while ((1 << bits) < numTechnicalSkills * 4) bits++;
+    return bits;
+}
+
+template<int Bits>
+constexpr int skillHashBits() {
+    if constexpr (Bits > 12) {
+        return -1;
+    } else {
+        return findSkillHashSeed<Bits>() < SKILL_HASH_SEEDS ? Bits : skillHashBits<Bits + 1>();
+    }
+}
+
+constexpr int SKILL_HASH_BITS = skillHashBits<smallestSkillHashBits()>();
+static_assert(SKILL_HASH_BITS > 0, "whitelisted skill names must be distinct ignoring case");
+
+constexpr SkillHashTable<SKILL_HASH_BITS> buildSkillHashTable() {
+    SkillHashTable<SKILL_HASH_BITS> table{};
+    table.place(findSkillHashSeed<SKILL_HASH_BITS>());
+    return table;
+}
+
+// Whitelisted name -> skill ID, generated by the compiler
+constexpr SkillHashTable<SKILL_HASH_BITS> skillHashTable = buildSkillHashTable();
+static_assert(skillHashTable.find("c++") == 4 && skillHashTable.find("POWER BI") == 10 && skillHashTable.find("Cobol") < 0,
+              "skill hash table lookup");
+
+// Fixed-width bitset of skill IDs
+struct SkillSet {
+    uint64_t words[SKILL_WORDS];
+
+    SkillSet() { clear(); }
+
+    void clear() {
+        for (int w = 0; w < SKILL_WORDS; w++) words[w] = 0;
+    }
+
+    void add(int skillId) {
+        words[skillId >> 6] |= (uint64_t)1 << (skillId & 63);
+    }
+
+    bool has(int skillId) const {
+        return (words[skillId >> 6] >> (skillId & 63)) & 1;
+    }
+
+    // this |= other
+    void merge(const SkillSet& other) {
+        for (int w = 0; w < SKILL_WORDS; w++) words[w] |= other.words[w];
+    }
+
+    bool operator==(const SkillSet& other) const {
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            if (words[w] != other.words[w]) return false;
+        }
+        return true;
+    }
+
+    bool empty() const {
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            if (words[w]) return false;
+        }
+        return true;
+    }
+
+    // Number of skills in the set
+    int count() const {
+        int total = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) total += popcount64(words[w]);
+        return total;
+    }
+
+    // popcount(this & other): number of shared skills
+    int countCommon(const SkillSet& other) const {
+        int total = 0;
+        for (int w = 0; w < SKILL_WORDS; w++) total += popcount64(words[w] & other.words[w]);
+        return total;
+    }
+
+    // Call fn(skillId) for every skill in the set, in ID order
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (int w = 0; w < SKILL_WORDS; w++) {
+            uint64_t bits = words[w];
+            while (bits) {
+                fn(w * 64 + countTrailingZeros64(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+};
+
+// Runtime counterpart of SkillHashTable for a taxonomy loaded from a file: case-folded names
+// and aliases -> skill ID, with the same hash. The table size and seed are searched when the
+// taxonomy is compiled, so a lookup is still one hash, one slot probe and one compare.
+class SkillNameTable {
+private:
+    vector<string> keys;        // case-folded
+    vector<int16_t> skillIds;   // skill ID of each key
+    vector<int16_t> slots;      // key index or -1
+    uint64_t seed;
+    int shift;                  // slot = hash >> shift
+
+    bool tryBuild(int bits, uint64_t candidateSeed) {
+        seed = candidateSeed;
+        shift = 64 - bits;
+        slots.assign((size_t)1 << bits, -1);
+        for (size_t k = 0; k < keys.size(); k++) {
+            size_t slot = skillNameHash(keys[k], seed) >> shift;
+            if (slots[slot] >= 0) return false;
+            slots[slot] = (int16_t)k;
+        }
+        return true;
+    }
+
+public:
+    SkillNameTable() : slots(2, -1), seed(0), shift(63) {}
+
+    // Compile the table for (name, skill ID) pairs; names must be distinct ignoring case
+    void build(const vector<pair<string, int>>& names) {
+        keys.clear();
+        skillIds.clear();
+        for (const pair<string, int>& name : names) {
+            string key = name.first;
+            for (char& c : key) c = (char)foldSkillChar((unsigned char)c);
+            keys.push_back(key);
+            skillIds.push_back((int16_t)name.second);
+        }
+        int bits = 2;
+        while (((size_t)1 << bits) < keys.size() * 4) bits++;
+        for (;; bits++) {
+            for (uint64_t candidate = 0; candidate < SKILL_HASH_SEEDS; candidate++) {
+                if (tryBuild(bits, candidate)) return;
+            }
+        }
+    }
+
+    // Skill ID of an exact (untrimmed) name or alias, ignoring case; -1 if unknown
+    int find(string_view text) const {
+        int k = slots[skillNameHash(text, seed) >> shift];
+        if (k < 0) return -1;
+        const string& key = keys[k];
+        if (key.size() != text.size()) return -1;
+        for (size_t i = 0; i < text.size(); i++) {
+            if (foldSkillChar((unsigned char)text[i]) != (unsigned char)key[i]) return -1;
+        }
+        return skillIds[k];
+    }
+};
+
+// Global skill dictionary: assigns each skill a dense integer ID. By default the skills are the
+// built-in whitelist (ID = whitelist position, looked up through the compile-time table); a
+// taxonomy file can replace them with its own skills, aliases and parent/child links.
+// Hierarchy is resolved once, into each skill's closure (the skill plus every skill above it):
+// encoding a record ORs in the closures, so a PostgreSQL record also carries the SQL bit, and the
+// scoring kernels and skill indexes match it against SQL with the same AND as an exact match.
+class SkillDictionary {
+private:
+    string names[MAX_SKILLS];         // canonical (proper case) names
+    string indexKeys[MAX_SKILLS];     // normalized names used as inverted index keys
+    SkillSet closure[MAX_SKILLS];     // the skill and its ancestors
+    vector<string> aliasNames;        // aliases as written in the taxonomy
+    vector<int> aliasSkills;          // skill ID of each alias
+    vector<string> aliasIndexKeys;    // normalized aliases (searched like the names)
+    SkillNameTable nameTable;         // names + aliases -> skill ID, for a loaded taxonomy
+    bool fromFile;
+    int count;
+
+public:
+    SkillDictionary() : fromFile(false), count(numTechnicalSkills) {
+        for (int i = 0; i < count; i++) {
+            names[i] = string(technicalSkills[i]);
+            indexKeys[i] = normalizeKey(names[i]);
+            closure[i].add(i);
+        }
+    }
+
+    // Optional taxonomy file replacing the built-in skills, one entry per line
+    // (lines starting with '#' are comments):
+    //   skill <name>                     - a canonical skill (IDs follow the order of these lines)
+    //   alias <skill> = <alias>, ...     - other spellings that mean the skill
+    //   parent <skill> = <parent>, ...   - a record with the skill also counts as having the parents
+    // Names and aliases match ignoring case. Returns false (keeping the current skills) if the
+    // file cannot be read or defines no skill; bad lines are reported and skipped.
+    // Must run before any record is encoded.
+    bool loadTaxonomy(const string& path);
+
+    int size() const { return count; }
+    int getAliasCount() const { return (int)aliasNames.size(); }
+    const string& getName(int skillId) const { return names[skillId]; }
+    const string& getIndexKey(int skillId) const { return indexKeys[skillId]; }
+
+    // Hash of everything that decides how skill text is encoded (names, aliases, hierarchy);
+    // snapshots built under another taxonomy are rejected with it
+    uint64_t fingerprint() const {
+        uint64_t h = 14695981039346656037ULL;
+        auto mix = [&h](const void* data, size_t length) {
+            for (size_t i = 0; i < length; i++) {
+                h ^= ((const unsigned char*)data)[i];
+                h *= 1099511628211ULL;
+            }
+        };
+        for (int i = 0; i < count; i++) {
+            mix(names[i].c_str(), names[i].size() + 1);
+            mix(closure[i].words, sizeof(closure[i].words));
+        }
+        for (size_t a = 0; a < aliasNames.size(); a++) {
+            mix(aliasNames[a].c_str(), aliasNames[a].size() + 1);
+            mix(&aliasSkills[a], sizeof(int));
+        }
+        return h;
+    }
+
+    // Case-insensitive lookup of an exact skill name or alias (no trimming), -1 if unknown
+    int matchSkill(string_view name) const { return fromFile ? nameTable.find(name) : skillHashTable.find(name); }
+
+    // Case-insensitive lookup of a single skill name or alias, ignoring surrounding whitespace; -1 if unknown
+    int findSkill(string_view name) const {
+        size_t start = name.find_first_not_of(" \t\r\n");
+        if (start == string_view::npos) return -1;
+        size_t end = name.find_last_not_of(" \t\r\n");
+        return matchSkill(name.substr(start, end - start + 1));
+    }
+
+    // All skills whose normalized name or alias contains the given normalized term
+    SkillSet skillsContaining(const string& normTerm) const {
+        SkillSet result;
+        if (normTerm.empty()) return result;
+        for (int i = 0; i < count; i++) {
+            if (indexKeys[i].find(normTerm) != string::npos) result.add(i);
+        }
+        for (size_t a = 0; a < aliasIndexKeys.size(); a++) {
+            if (aliasIndexKeys[a].find(normTerm) != string::npos) result.add(aliasSkills[a]);
+        }
+        return result;
+    }
+
+    // Encode a comma-separated skill list into a skill bitset: every known skill with its
+    // ancestors (unknown skills are ignored)
+    SkillSet encode(string_view skillList) const {
+        SkillSet result;
+        size_t pos = 0;
+        while (pos <= skillList.size()) {
+            size_t comma = skillList.find(',', pos);
+            if (comma == string_view::npos) comma = skillList.size();
+            int skillId = findSkill(skillList.substr(pos, comma - pos));
+            if (skillId >= 0) result.merge(closure[skillId]);
+            pos = comma + 1;
+        }
+        return result;
+    }
+};
+
+bool SkillDictionary::loadTaxonomy(const string& path) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+
+    struct Link {
+        string skill;
+        string value;
+        int lineNumber;
+    };
+    vector<pair<string, int>> skillLines;   // name, line number
+    vector<Link> aliasLinks, parentLinks;
+    auto trim = [](const string& text) {
+        size_t start = text.find_first_not_of(" \t\r");
+        if (start == string::npos) return string();
+        return text.substr(start, text.find_last_not_of(" \t\r") - start + 1);
+    };
+    auto warn = [&path](int lineNumber, const string& what) {
+        cerr << "Warning: " << path << ":" << lineNumber << ": ignoring " << what << endl;
+    };
+
+    string line;
+    int lineNumber = 0;
+    while (getline(file, line)) {
+        lineNumber++;
+        string text = trim(line);
+        if (text.empty() || text[0] == '#') continue;
+
+        size_t space = text.find_first_of(" \t");
+        string kind = text.substr(0, space);
+        string rest = space == string::npos ? "" : text.substr(space + 1);
+        size_t equals = rest.find('=');
+        string name = trim(rest.substr(0, equals));
+        string value = equals == string::npos ? "" : trim(rest.substr(equals + 1));
+
+        if (kind == "skill" && equals == string::npos && !name.empty()) {
+            skillLines.push_back({name, lineNumber});
+        } else if ((kind == "alias" || kind == "parent") && !name.empty() && !value.empty()) {
+            vector<Link>& links = kind == "alias" ? aliasLinks : parentLinks;
+            size_t pos = 0;
+            while (pos <= value.size()) {
+                size_t comma = value.find(',', pos);
+                if (comma == string::npos) comma = value.size();
+                string item = trim(value.substr(pos, comma - pos));
+                if (!item.empty()) links.push_back({name, item, lineNumber});
+                pos = comma + 1;
+            }
+        } else {
+            warn(lineNumber, "'" + text + "'");
+        }
+    }
+
+    // Case-folded name or alias -> skill ID
+    map<string, int> ids;
+    auto folded = [](const string& text) {
+        string key = text;
+        for (char& c : key) c = (char)foldSkillChar((unsigned char)c);
+        return key;
+    };
+    auto findId = [&](const string& text) {
+        map<string, int>::const_iterator it = ids.find(folded(text));
+        return it == ids.end() ? -1 : it->second;
+    };
+
+    vector<string> skillNames;
+    for (const pair<string, int>& skill : skillLines) {
+        if (findId(skill.first) >= 0) {
+            warn(skill.second, "duplicate skill '" + skill.first + "'");
+        } else if ((int)skillNames.size() == MAX_SKILLS) {
+            warn(skill.second, "skill '" + skill.first + "' (at most " + to_string(MAX_SKILLS) + " skills)");
+        } else {
+            ids[folded(skill.first)] = (int)skillNames.size();
+            skillNames.push_back(skill.first);
+        }
+    }
+    if (skillNames.empty()) {
+        cerr << "Warning: " << path << " defines no skills; keeping the built-in skill list" << endl;
+        return false;
+    }
+
+    vector<pair<string, int>> aliases;
+    for (const Link& link : aliasLinks) {
+        int skillId = findId(link.skill);
+        if (skillId < 0) warn(link.lineNumber, "alias of unknown skill '" + link.skill + "'");
+        else if (findId(link.value) >= 0) warn(link.lineNumber, "alias '" + link.value + "' (already a skill or alias)");
+        else {
+            ids[folded(link.value)] = skillId;
+            aliases.push_back({link.value, skillId});
+        }
+    }
+
+    // Direct parents, then the transitive closure (cycles simply share their closures)
+    vector<SkillSet> skillClosure(skillNames.size());
+    for (size_t i = 0; i < skillNames.size(); i++) skillClosure[i].add((int)i);
+    for (const Link& link : parentLinks) {
+        int skillId = findId(link.skill);
+        int parentId = findId(link.value);
+        if (skillId < 0 || parentId < 0) warn(link.lineNumber, "parent link '" + link.skill + " = " + link.value + "' (unknown skill)");
+        else skillClosure[skillId].add(parentId);
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (SkillSet& skills : skillClosure) {
+            SkillSet expanded = skills;
+            skills.forEach([&](int ancestor) { expanded.merge(skillClosure[ancestor]); });
+            if (!(expanded == skills)) {
+                skills = expanded;
+                changed = true;
+            }
+        }
+    }
+
+    count = (int)skillNames.size();
+    for (int i = 0; i < count; i++) {
+        names[i] = skillNames[i];
+        indexKeys[i] = normalizeKey(skillNames[i]);
+        closure[i] = skillClosure[i];
+    }
+    aliasNames.clear();
+    aliasSkills.clear();
+    aliasIndexKeys.clear();
+    vector<pair<string, int>> tableNames;
+    for (int i = 0; i < count; i++) tableNames.push_back({names[i], i});
+    for (const pair<string, int>& alias : aliases) {
+        aliasNames.push_back(alias.first);
+        aliasSkills.push_back(alias.second);
+        aliasIndexKeys.push_back(normalizeKey(alias.first));
+        tableNames.push_back(alias);
+    }
+    nameTable.build(tableNames);
+    fromFile = true;
+    return true;
+}
+
+SkillDictionary skillDictionary;
+
+// Keep only the known skills of a raw comma-separated list, in their canonical spelling,
+// joined by ", " ("Not specified" if none is left). Used by the data cleaner and by records
+// parsed from raw descriptions.
+inline string filterTechnicalSkills(string_view rawSkills) {
+    string filtered;
+    size_t pos = 0;
+    while (pos < rawSkills.size()) {
+        size_t comma = rawSkills.find(',', pos);
+        if (comma == string_view::npos) comma = rawSkills.size();
+        string_view skill = rawSkills.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        // Trim whitespace
+        size_t start = skill.find_first_not_of(" \t");
+        if (start == string_view::npos) continue;
+        skill = skill.substr(start, skill.find_last_not_of(" \t") - start + 1);
+
+        int skillId = skillDictionary.matchSkill(skill);
+        if (skillId < 0) continue;
+        if (!filtered.empty()) filtered += ", ";
+        filtered += skillDictionary.getName(skillId);
+    }
+    return filtered.empty() ? "Not specified" : filtered;
+}
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef SNAPSHOT_CPP
+#define SNAPSHOT_CPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <type_traits>
+using namespace std;
+
+// Binary snapshot file layout (native byte order):
+//   SnapshotHeader
+//   payload - fixed-size values, length-prefixed strings and length-prefixed arrays,
+//             read back in exactly the order they were written
+// The checksum covers the whole payload. Bump SNAPSHOT_VERSION whenever anything
+// written into the payload changes; older snapshots are then simply rebuilt.
+
+const char SNAPSHOT_MAGIC[8] = {'J', 'M', 'S', 'N', 'A', 'P', '\0', '\0'};
+const uint32_t SNAPSHOT_VERSION = 4;
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;   // sizeof(SnapshotHeader), catches layout changes
+    uint64_t payloadBytes;
+    uint64_t checksum;      // FNV-1a of the payload
+};
+
+// 64-bit FNV-1a
+inline uint64_t snapshotChecksum(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Serializes values into an in-memory payload, then writes header + payload to disk
+class SnapshotWriter {
+private:
+    vector<char> payload;
+
+public:
+    void putBytes(const void* data, size_t length) {
+        const char* bytes = (const char*)data;
+        payload.insert(payload.end(), bytes, bytes + length);
+    }
+
+    template<typename V>
+    void put(const V& value) {
+        static_assert(is_trivially_copyable<V>::value, "snapshot values must be trivially copyable");
+        putBytes(&value, sizeof(V));
+    }
+
+    void putString(const string& text) {
+        put<uint32_t>((uint32_t)text.size());
+        putBytes(text.data(), text.size());
+    }
+
+    template<typename V>
+    void putArray(const vector<V>& values) {
+        static_assert(is_trivially_copyable<V>::value, "snapshot values must be trivially copyable");
+        put<uint64_t>(values.size());
+        putBytes(values.data(), values.size() * sizeof(V));
+    }
+
+    // Write to a temporary file and rename it into place, so readers never see a partial snapshot
+    bool writeFile(const string& path) const {
+        SnapshotHeader header;
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.headerBytes = sizeof(SnapshotHeader);
+        header.payloadBytes = payload.size();
+        header.checksum = snapshotChecksum(payload.data(), payload.size());
+
+        string tempPath = path + ".tmp";
+        {
+            ofstream file(tempPath, ios::binary | ios::trunc);
+            if (!file.is_open()) return false;
+            file.write((const char*)&header, sizeof(header));
+            file.write(payload.data(), payload.size());
+            if (!file.good()) {
+                file.close();
+                remove(tempPath.c_str());
+                return false;
+            }
+        }
+#ifdef _WIN32
+        remove(path.c_str()); // rename does not replace an existing file on Windows
+#endif
+        if (rename(tempPath.c_str(), path.c_str()) != 0) {
+            remove(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+};
+
+// Reads values back out of a (memory-mapped) snapshot.
+// Any read past the end marks the reader as failed; check ok() after reading a section.
+class SnapshotReader {
+private:
+    const char* pos;
+    const char* end;
+    bool valid;
+
+public:
+    SnapshotReader() : pos(nullptr), end(nullptr), valid(false) {}
+
+    // Verify magic, version and checksum; on success the reader is positioned at the payload
+    bool open(const char* data, size_t length) {
+        valid = false;
+        SnapshotHeader header;
+        if (data == nullptr || length < sizeof(header)) return false;
+        memcpy(&header, data, sizeof(header));
+        if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) return false;
+        if (header.version != SNAPSHOT_VERSION || header.headerBytes != sizeof(SnapshotHeader)) return false;
+        if (header.payloadBytes != length - sizeof(header)) return false;
+
+        const char* payload = data + sizeof(header);
+        if (snapshotChecksum(payload, header.payloadBytes) != header.checksum) return false;
+        pos = payload;
+        end = payload + header.payloadBytes;
+        valid = true;
+        return true;
+    }
+
+    bool ok() const { return valid; }
+    bool atEnd() const { return pos == end; }
+
+    bool getBytes(void* out, size_t length) {
+        if (!valid || (size_t)(end - pos) < length) {
+            valid = false;
+            return false;
+        }
+        memcpy(out, pos, length);
+        pos += length;
+        return true;
+    }
+
+    template<typename V>
+    V get() {
+        static_assert(is_trivially_copyable<V>::value, "snapshot values must be trivially copyable");
+        V value{};
+        getBytes(&value, sizeof(V));
+        return value;
+    }
+
+    string getString() {
+        uint32_t length = get<uint32_t>();
+        if (!valid || (size_t)(end - pos) < length) {
+            valid = false;
+            return string();
+        }
+        string text(pos, length);
+        pos += length;
+        return text;
+    }
+
+    template<typename V>
+    bool getArray(vector<V>& values) {
+        uint64_t count = get<uint64_t>();
+        if (!valid || count > (uint64_t)(end - pos) / sizeof(V)) {
+            valid = false;
+            values.clear();
+            return false;
+        }
+        values.resize(count);
+        return getBytes(values.data(), count * sizeof(V));
+    }
+};
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef THREAD_POOL_CPP
+#define THREAD_POOL_CPP
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <chrono>
+using namespace std;
+
+// Per-worker counters reported after a parallel run
+struct WorkerStats {
+    long long tasksRun;     // tasks (chunks) executed by this worker
+    long long tasksStolen;  // tasks taken from another worker's queue
+    long long items;        // items processed (parallelFor only)
+    double busySeconds;     // time spent inside tasks
+};
+
+// Work-stealing thread pool.
+// Every worker owns a task deque: it pops its own newest task from the back and,
+// when empty, steals the oldest task from the front of another worker's deque.
+class WorkStealingPool {
+private:
+    typedef function<void(int)> Task; // argument is the worker ID
+
+    struct WorkerQueue {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    int numThreads;
+    vector<thread> workers;
+    vector<unique_ptr<WorkerQueue>> queues;
+    vector<WorkerStats> stats;
+
+    mutex stateLock;
+    condition_variable workAvailable;
+    condition_variable allDone;
+    atomic<long long> pendingTasks;
+    atomic<int> nextQueue;
+    long long submitVersion;   // bumped under stateLock on every submit
+    bool stopping;
+
+    static thread_local bool onWorker; // set on every pool's worker threads
+
+    bool popLocal(int workerId, Task& task);
+    bool steal(int workerId, Task& task);
+    void workerLoop(int workerId);
+
+public:
+    // threads <= 0 uses every hardware thread
+    WorkStealingPool(int threads = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int getThreadCount() const { return numThreads; }
+    static int defaultThreadCount();
+
+    // True on a worker thread of any pool. Code running there must not parallelFor on the same
+    // pool (wait() would wait for itself), and splitting its work again only adds threads.
+    static bool onWorkerThread() { return onWorker; }
+
+    // Queue a task (round-robin over the worker deques)
+    void submit(const Task& task);
+
+    // Block until every submitted task has finished
+    void wait();
+
+    // Split [begin, end) into chunks and run body(chunkBegin, chunkEnd, workerId) in parallel
+    void parallelFor(int begin, int end, int chunkSize, const function<void(int, int, int)>& body);
+
+    const WorkerStats& getStats(int workerId) const { return stats[workerId]; }
+    void resetStats();
+};
+
+thread_local bool WorkStealingPool::onWorker = false;
+
+int WorkStealingPool::defaultThreadCount() {
+    unsigned int hardware = thread::hardware_concurrency();
+    return hardware > 0 ? (int)hardware : 1;
+}
+
+WorkStealingPool::WorkStealingPool(int threads)
+    : numThreads(threads > 0 ? threads : defaultThreadCount()), pendingTasks(0), nextQueue(0), submitVersion(0), stopping(false) {
+    stats.resize(numThreads);
+    resetStats();
+    for (int i = 0; i < numThreads; i++) {
+        queues.emplace_back(new WorkerQueue());
+    }
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        lock_guard<mutex> guard(stateLock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkStealingPool::resetStats() {
+    for (WorkerStats& s : stats) {
+        s.tasksRun = 0;
+        s.tasksStolen = 0;
+        s.items = 0;
+        s.busySeconds = 0;
+    }
+}
+
+void WorkStealingPool::submit(const Task& task) {
+    int target = nextQueue.fetch_add(1) % numThreads;
+    pendingTasks.fetch_add(1);
+    {
+        lock_guard<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(task);
+    }
+    {
+        lock_guard<mutex> guard(stateLock);
+        submitVersion++;
+    }
+    workAvailable.notify_all();
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> guard(stateLock);
+    allDone.wait(guard, [this] { return pendingTasks.load() == 0; });
+}
+
+bool WorkStealingPool::popLocal(int workerId, Task& task) {
+    WorkerQueue& queue = *queues[workerId];
+    lock_guard<mutex> guard(queue.lock);
+    if (queue.tasks.empty()) return false;
+    task = move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(int workerId, Task& task) {
+    for (int offset = 1; offset < numThreads; offset++) {
+        WorkerQueue& victim = *queues[(workerId + offset) % numThreads];
+        lock_guard<mutex> guard(victim.lock);
+        if (!victim.tasks.empty()) {
+            task = move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int workerId) {
+    onWorker = true;
+    while (true) {
+        long long seenVersion;
+        {
+            lock_guard<mutex> guard(stateLock);
+            seenVersion = submitVersion;
+        }
+
+        Task task;
+        bool stolen = false;
+        if (!popLocal(workerId, task)) {
+            stolen = steal(workerId, task);
+            if (!stolen) {
+                // Nothing to do: sleep until something is submitted or the pool shuts down
+                unique_lock<mutex> guard(stateLock);
+                workAvailable.wait(guard, [this, seenVersion] {
+                    return stopping || submitVersion != seenVersion;
+                });
+                if (stopping) return;
+                continue;
+            }
+        }
+
+        auto start = chrono::steady_clock::now();
+        task(workerId);
+        auto finish = chrono::steady_clock::now();
+
+        stats[workerId].tasksRun++;
+        if (stolen) stats[workerId].tasksStolen++;
+        stats[workerId].busySeconds += chrono::duration<double>(finish - start).count();
+
+        if (pendingTasks.fetch_sub(1) == 1) {
+            lock_guard<mutex> guard(stateLock);
+            allDone.notify_all();
+        }
+    }
+}
+
+void WorkStealingPool::parallelFor(int begin, int end, int chunkSize, const function<void(int, int, int)>& body) {
+    if (chunkSize < 1) chunkSize = 1;
+    for (int chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize) {
+        int chunkEnd = min(end, chunkBegin + chunkSize);
+        submit([this, &body, chunkBegin, chunkEnd](int workerId) {
+            body(chunkBegin, chunkEnd, workerId);
+            stats[workerId].items += chunkEnd - chunkBegin;
+        });
+    }
+    wait();
+}
+
+// Blocking FIFO with a fixed capacity, used between pipeline stages.
+// push waits while the queue is full, pop waits while it is empty.
+// After close() pushes are refused and pop drains the remaining items, then returns false.
+template<typename T>
+class BoundedQueue {
+private:
+    mutex lock;
+    condition_variable notFull;
+    condition_variable notEmpty;
+    deque<T> items;
+    size_t capacity;
+    bool closed;
+
+public:
+    explicit BoundedQueue(size_t maxItems) : capacity(maxItems > 0 ? maxItems : 1), closed(false) {}
+
+    bool push(T item) {
+        unique_lock<mutex> guard(lock);
+        notFull.wait(guard, [this] { return closed || items.size() < capacity; });
+        if (closed) return false;
+        items.push_back(move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    bool pop(T& item) {
+        unique_lock<mutex> guard(lock);
+        notEmpty.wait(guard, [this] { return closed || !items.empty(); });
+        if (items.empty()) return false;
+        item = move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        lock_guard<mutex> guard(lock);
+        closed = true;
+        notFull.notify_all();
+        notEmpty.notify_all();
+    }
+};
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef TOP_K_CPP
+#define TOP_K_CPP
+
+#include <vector>
+#include <algorithm>
+#include "thread_pool.cpp"
+using namespace std;
+
+// Match struct for storing search results
+struct Match {
+    int index;
+    int score;
+};
+
+// Result order: higher score first, ties broken by lower index (so results never depend
+// on the order candidates were offered in, or on how the work was split across threads)
+inline bool rankedBefore(const Match& a, const Match& b) {
+    return a.score != b.score ? a.score > b.score : a.index < b.index;
+}
+
+// Streaming top-K selection over a bounded heap: O(N log K) for N offers, O(K) memory.
+// The heap root is the worst match kept, so most offers are rejected with one comparison.
+// Collectors filled on different threads can be merged.
+class TopKCollector {
+private:
+    int limit;
+    vector<Match> heap; // heap ordered by rankedBefore: the root ranks last
+
+public:
+    explicit TopKCollector(int k) : limit(max(k, 0)) {}
+
+    int capacity() const { return limit; }
+    int size() const { return (int)heap.size(); }
+    bool empty() const { return heap.empty(); }
+    bool full() const { return (int)heap.size() >= limit; }
+
+    // Worst match kept; a new match must rank before it to get in (only valid when full)
+    const Match& worst() const { return heap.front(); }
+
+    // True if a match with this index and (at most) this score could still get in
+    bool canEnter(int index, long long score) const {
+        if (!full()) return limit > 0 && score > 0;
+        const Match& last = heap.front();
+        return score > last.score || (score == last.score && index < last.index);
+    }
+
+    // Lowest score that can still enter the collector
+    int threshold() const { return full() && limit > 0 ? heap.front().score : -2147483647 - 1; }
+
+    void offer(int index, int score) {
+        Match match = {index, score};
+        if (!full()) {
+            heap.push_back(match);
+            push_heap(heap.begin(), heap.end(), rankedBefore);
+        } else if (limit > 0 && rankedBefore(match, heap.front())) {
+            pop_heap(heap.begin(), heap.end(), rankedBefore);
+            heap.back() = match;
+            push_heap(heap.begin(), heap.end(), rankedBefore);
+        }
+    }
+
+    // Add every match of another collector (e.g. one filled by another thread)
+    void merge(const TopKCollector& other) {
+        for (const Match& match : other.heap) offer(match.index, match.score);
+    }
+
+    // The kept matches, best first
+    vector<Match> sortedResults() const {
+        vector<Match> results = heap;
+        sort(results.begin(), results.end(), rankedBefore);
+        return results;
+    }
+
+    void clear() { heap.clear(); }
+};
+
+// Candidate lists at least this long are scored in parallel
+const int PARALLEL_SCORING_MIN_CANDIDATES = 4096;
+
+// All-cores pool shared by every parallel search, started on first use
+inline WorkStealingPool& searchScoringPool() {
+    static WorkStealingPool pool;
+    return pool;
+}
+
+// Score every candidate with score(docId) and keep the best in top (scores <= 0 are dropped).
+// Long candidate lists are split across the shared search pool with one collector per worker;
+// the collectors are merged at the end. A search already running on a pool worker (e.g. a
+// server request) is scored on its own thread: the requests themselves keep the cores busy.
+// Returns how many candidates scored above zero.
+template<typename ScoreFunction>
+int collectTopMatches(const vector<int>& candidates, ScoreFunction score, TopKCollector& top) {
+    int candidateCount = (int)candidates.size();
+    if (candidateCount < PARALLEL_SCORING_MIN_CANDIDATES || WorkStealingPool::onWorkerThread()) {
+        int matchCount = 0;
+        for (int docId : candidates) {
+            int docScore = score(docId);
+            if (docScore <= 0) continue;
+            top.offer(docId, docScore);
+            matchCount++;
+        }
+        return matchCount;
+    }
+
+    WorkStealingPool& pool = searchScoringPool();
+    vector<TopKCollector> workerTops(pool.getThreadCount(), TopKCollector(top.capacity()));
+    vector<int> workerCounts(pool.getThreadCount(), 0);
+    pool.parallelFor(0, candidateCount, 1024, [&](int first, int last, int workerId) {
+        for (int i = first; i < last; i++) {
+            int docScore = score(candidates[i]);
+            if (docScore <= 0) continue;
+            workerTops[workerId].offer(candidates[i], docScore);
+            workerCounts[workerId]++;
+        }
+    });
+
+    int matchCount = 0;
+    for (int w = 0; w < pool.getThreadCount(); w++) {
+        top.merge(workerTops[w]);
+        matchCount += workerCounts[w];
+    }
+    return matchCount;
+}
+
+#endif